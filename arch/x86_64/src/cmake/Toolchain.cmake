@@ -176,6 +176,10 @@ if(CONFIG_ARCH_X86_64_SSE4A)
   add_compile_options(-msse4a)
 endif()
 
+if(CONFIG_ARCH_X86_64_PCLMUL)
+  add_compile_options(-mpclmul)
+endif()
+
 if(CONFIG_ARCH_X86_64_AVX)
   add_compile_options(-mavx)
 endif()
@@ -35,6 +35,7 @@
 
 #include <nuttx/mutex.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -42,10 +43,26 @@
 
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#define BCH_NLINES        CONFIG_BCH_CACHE_NLINES
+#define BCH_LINESECTORS   CONFIG_BCH_CACHE_LINESECTORS
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One line of the sector cache.  A line holds BCH_LINESECTORS consecutive
+ * sectors starting at a multiple of BCH_LINESECTORS.
+ */
+
+struct bch_line_s
+{
+  size_t sector;           /* First sector of the line */
+  uint32_t valid;          /* Bit set of sectors holding device data */
+  uint32_t dirty;          /* Bit set of sectors not yet written back */
+  uint32_t lru;            /* Value of the LRU clock at the last access */
+  FAR uint8_t *buffer;     /* Data of the line */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
@@ -54,10 +71,14 @@ struct bchlib_s
   size_t sector;           /* The current sector in the buffer */
   mutex_t lock;            /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  FAR uint8_t *buffer;     /* Data of the current sector */
+  FAR uint8_t *pool;       /* Memory holding the data of all lines */
+  FAR struct bch_line_s *line;           /* Line holding the current sector */
+  struct bch_line_s cache[BCH_NLINES];   /* The sector cache */
+  uint32_t lru;                          /* LRU clock */
+  struct bch_cachestats_s stats;         /* Cache statistics */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -85,6 +106,11 @@ EXTERN const struct file_operations g_bch_fops;
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN void bchlib_dirtysector(FAR struct bchlib_s *bch);
+EXTERN void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
+EXTERN void bchlib_mergedirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                              size_t sector, size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -29,6 +29,8 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
+#include <strings.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -62,29 +64,35 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *data,
+                      size_t sector, size_t nsectors, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)data;
   int i;
 
-  for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
+  for (; nsectors > 0; nsectors--, sector++)
     {
-      uint32_t T[4];
-      uint32_t X[4] =
-      {
-        bch->sector, 0, 0, i
-      };
-
-      aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
-                 AES_MODE_ECB, CYPHER_ENCRYPT);
-
-      /* Xor-Encrypt-Xor */
-
-      bch_xor(T, X, buffer);
-      aes_cypher(T, T, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
-                 AES_MODE_ECB, encrypt);
-      bch_xor(buffer, X, T);
+      for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t))
+        {
+          uint32_t T[4];
+          uint32_t X[4] =
+          {
+            sector, 0, 0, i
+          };
+
+          aes_cypher(X, X, 16, NULL, bch->key,
+                     CONFIG_BCH_ENCRYPTION_KEY_SIZE,
+                     AES_MODE_ECB, CYPHER_ENCRYPT);
+
+          /* Xor-Encrypt-Xor */
+
+          bch_xor(T, X, buffer);
+          aes_cypher(T, T, 16, NULL, bch->key,
+                     CONFIG_BCH_ENCRYPTION_KEY_SIZE,
+                     AES_MODE_ECB, encrypt);
+          bch_xor(buffer, X, T);
+        }
     }
 
   return OK;
@@ -92,59 +100,155 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bch_flushline
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
- *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ *   Write back the dirty sectors of one cache line, issuing one request
+ *   per contiguous run of dirty sectors.
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
+static int bch_flushline(FAR struct bchlib_s *bch,
+                         FAR struct bch_line_s *line)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
-
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
-   */
+  FAR struct inode *inode = bch->inode;
+  ssize_t ret;
+  int first;
+  int last;
 
-  if (bch->dirty && bch->buffer != NULL)
+  while (line->dirty != 0)
     {
-      inode = bch->inode;
+      FAR uint8_t *data;
+
+      /* Find the next run of dirty sectors */
+
+      first = ffs(line->dirty) - 1;
+      for (last = first + 1;
+           last < BCH_LINESECTORS && (line->dirty & (1u << last)) != 0;
+           last++);
+
+      data = line->buffer + first * bch->sectsize;
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+      bch_cypher(bch, data, line->sector + first, last - first,
+                 CYPHER_ENCRYPT);
 #endif
 
-      /* Write the sector to the media */
+      /* Write the sectors to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
-        {
-          ferr("Write failed: %zd\n", ret);
-          return (int)ret;
-        }
+      ret = inode->u.i_bops->write(inode, data, line->sector + first,
+                                   last - first);
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Computation overhead to save memory for extra sector buffer
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, data, line->sector + first, last - first,
+                 CYPHER_DECRYPT);
 #endif
 
-      /* The sector is now in sync with the media */
+      if (ret < 0)
+        {
+          ferr("Write failed: %zd\n", ret);
+          return (int)ret;
+        }
+
+      /* The sectors are now in sync with the media */
+
+      bch->stats.flushes++;
+      for (; first < last; first++)
+        {
+          line->dirty &= ~(1u << first);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bch_findline
+ *
+ * Description:
+ *   Return the cache line for 'sector', replacing the least recently used
+ *   line if the sector is not cached.
+ *
+ ****************************************************************************/
+
+static int bch_findline(FAR struct bchlib_s *bch, size_t sector,
+                        FAR struct bch_line_s **result)
+{
+  FAR struct bch_line_s *victim = &bch->cache[0];
+  size_t base = sector - sector % BCH_LINESECTORS;
+  int ret;
+  int i;
+
+  for (i = 0; i < BCH_NLINES; i++)
+    {
+      FAR struct bch_line_s *line = &bch->cache[i];
+
+      if (line->valid != 0 && line->sector == base)
+        {
+          *result = line;
+          return OK;
+        }
+
+      /* Prefer an unused line, otherwise the least recently used */
+
+      if (victim->valid != 0 &&
+          (line->valid == 0 || (int32_t)(line->lru - victim->lru) < 0))
+        {
+          victim = line;
+        }
+    }
+
+  ret = bch_flushline(bch, victim);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  victim->sector = base;
+  victim->valid  = 0;
+  *result        = victim;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the dirty contents of the sector cache.  If 'discard' is true,
+ *   then the cache is also emptied.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < BCH_NLINES; i++)
+    {
+      ret = bch_flushline(bch, &bch->cache[i]);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
-      bch->dirty = false;
+      if (discard)
+        {
+          bch->cache[i].valid = 0;
+        }
     }
 
   if (discard)
@@ -152,14 +256,15 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
       bch->sector = (size_t)-1;
     }
 
-  return (int)ret;
+  return OK;
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Read the current sector contents into buffer
+ *   Make 'sector' the current sector, reading it into the cache if it is
+ *   not already there.  On return bch->buffer points to its data.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -169,45 +274,187 @@ int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
   FAR struct inode *inode;
-  ssize_t ret = OK;
+  FAR struct bch_line_s *line;
+  bool sequential;
+  ssize_t ret;
+  int index;
+  int last;
+  int i;
 
-  if (bch->buffer == NULL)
+  if (bch->pool == NULL)
     {
+      size_t size = (size_t)bch->sectsize * BCH_LINESECTORS * BCH_NLINES;
+
 #if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-      bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
+      bch->pool = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, size);
 #else
-      bch->buffer = kmm_malloc(bch->sectsize);
+      bch->pool = kmm_malloc(size);
 #endif
-      if (bch->buffer == NULL)
+      if (bch->pool == NULL)
         {
           ferr("Failed to allocate sector buffer\n");
           return -ENOMEM;
         }
+
+      for (i = 0; i < BCH_NLINES; i++)
+        {
+          bch->cache[i].buffer = bch->pool +
+                                 (size_t)i * BCH_LINESECTORS * bch->sectsize;
+        }
     }
 
-  if (bch->sector != sector)
+  sequential = bch->sector != (size_t)-1 && sector == bch->sector + 1;
+
+  ret = bch_findline(bch, sector, &line);
+  if (ret < 0)
     {
-      inode = bch->inode;
+      ferr("Flush failed: %zd\n", ret);
+      return (int)ret;
+    }
 
-      ret = bchlib_flushsector(bch, true);
-      if (ret < 0)
+  index = sector - line->sector;
+  if ((line->valid & (1u << index)) != 0)
+    {
+      bch->stats.hits++;
+    }
+  else
+    {
+      /* On a sequential miss, read ahead up to the end of the line (or the
+       * next sector that is already cached, which may be dirty).
+       */
+
+      last = index + 1;
+      if (sequential)
         {
-          ferr("Flush failed: %zd\n", ret);
-          return (int)ret;
+          while (last < BCH_LINESECTORS &&
+                 line->sector + last < bch->nsectors &&
+                 (line->valid & (1u << last)) == 0)
+            {
+              last++;
+            }
         }
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      inode = bch->inode;
+      ret = inode->u.i_bops->read(inode,
+                                  line->buffer + index * bch->sectsize,
+                                  sector, last - index);
       if (ret < 0)
         {
           ferr("Read failed: %zd\n", ret);
           return (int)ret;
         }
 
-      bch->sector = sector;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, line->buffer + index * bch->sectsize, sector,
+                 last - index, CYPHER_DECRYPT);
 #endif
+
+      for (i = index; i < last; i++)
+        {
+          line->valid |= 1u << i;
+        }
+
+      bch->stats.misses++;
+      bch->stats.readahead += last - index - 1;
+    }
+
+  line->lru   = ++bch->lru;
+  bch->line   = line;
+  bch->sector = sector;
+  bch->buffer = line->buffer + index * bch->sectsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_dirtysector
+ *
+ * Description:
+ *   Mark the current sector (the last one passed to bchlib_readsector())
+ *   as modified.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_dirtysector(FAR struct bchlib_s *bch)
+{
+  DEBUGASSERT(bch->line != NULL && bch->sector != (size_t)-1);
+  bch->line->dirty |= 1u << (bch->sector - bch->line->sector);
+}
+
+/****************************************************************************
+ * Name: bchlib_invalidate
+ *
+ * Description:
+ *   Drop any cached copy of the sectors in the given range.  This is used
+ *   before the range is written directly to the device; any dirty data for
+ *   the range must already have been flushed or be superseded.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                       size_t nsectors)
+{
+  int i;
+  int j;
+
+  for (i = 0; i < BCH_NLINES; i++)
+    {
+      FAR struct bch_line_s *line = &bch->cache[i];
+
+      for (j = 0; j < BCH_LINESECTORS; j++)
+        {
+          if (line->sector + j >= sector &&
+              line->sector + j < sector + nsectors)
+            {
+              line->valid &= ~(1u << j);
+              line->dirty &= ~(1u << j);
+            }
+        }
     }
 
-  return (int)ret;
+  if (bch->sector >= sector && bch->sector < sector + nsectors)
+    {
+      bch->sector = (size_t)-1;
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_mergedirty
+ *
+ * Description:
+ *   Copy any dirty cached sectors in the given range over data that was
+ *   just read directly from the device into 'buffer', so that the caller
+ *   sees its own unflushed writes.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_mergedirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                       size_t sector, size_t nsectors)
+{
+  int i;
+  int j;
+
+  for (i = 0; i < BCH_NLINES; i++)
+    {
+      FAR struct bch_line_s *line = &bch->cache[i];
+
+      for (j = 0; line->dirty != 0 && j < BCH_LINESECTORS; j++)
+        {
+          if ((line->dirty & (1u << j)) != 0 &&
+              line->sector + j >= sector &&
+              line->sector + j < sector + nsectors)
+            {
+              memcpy(buffer + (line->sector + j - sector) * bch->sectsize,
+                     line->buffer + j * bch->sectsize, bch->sectsize);
+            }
+        }
+    }
 }
@@ -156,6 +156,10 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           return ret;
         }
 
+      /* The cache may hold newer data than the media */
+
+      bchlib_mergedirty(bch, (FAR uint8_t *)buffer, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector    += nsectors;
@@ -72,9 +72,9 @@ int bchlib_teardown(FAR void *handle)
 
   /* Free the BCH state structure */
 
-  if (bch->buffer)
+  if (bch->pool)
     {
-      kmm_free(bch->buffer);
+      kmm_free(bch->pool);
     }
 
   nxmutex_destroy(&bch->lock);
@@ -105,7 +105,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
         }
 
       memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      bchlib_dirtysector(bch);
 
       /* Adjust pointers and counts */
 
@@ -133,16 +133,19 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Flush the dirty sector to keep the sector sequence */
+      /* Flush the dirty sectors to keep the sector sequence and drop any
+       * cached copies of the sectors about to be overwritten.
+       */
 
-      ret = bchlib_flushsector(bch, sector <= bch->sector &&
-                               bch->sector < (sector + nsectors));
+      ret = bchlib_flushsector(bch, false);
       if (ret < 0)
         {
           ferr("ERROR: Flush failed: %d\n", ret);
           return ret;
         }
 
+      bchlib_invalidate(bch, sector, nsectors);
+
       /* Write the contiguous sectors */
 
       ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
@@ -183,7 +186,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
       /* Copy the head end of the sector from the user buffer */
 
       memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      bchlib_dirtysector(bch);
 
       /* Adjust counts */
 
@@ -36,9 +36,11 @@
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/can.h>
+#include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 
@@ -87,6 +89,18 @@ struct netdev_upperhalf_s
 #if CONFIG_IOB_NCHAINS > 0
   struct iob_queue_s txq;
 #endif
+
+  /* Receive coalescing: the TCP segment that later segments are appended
+   * to.  Only touched with the network locked, and always passed on
+   * before the lock is released.
+   */
+
+#ifdef CONFIG_NETDEV_GRO
+  FAR netpkt_t *gro_pkt;    /* The held segment, NULL if none */
+  uint32_t      gro_seqno;  /* Sequence number of the next segment */
+  uint16_t      gro_paylen; /* TCP payload length of the held segment */
+  uint16_t      gro_paysum; /* Checksum of that payload */
+#endif
 };
 
 /****************************************************************************
@@ -248,6 +262,287 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   return quota > 0;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_transmit
+ *
+ * Description:
+ *   Pass a packet to the lower half, on the TX queue its flow hashes to
+ *   when the device has more than one.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static int netdev_upper_transmit(FAR struct netdev_lowerhalf_s *lower,
+                                 FAR netpkt_t *pkt)
+{
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  FAR struct netdev_queue_stats_s *stats;
+  unsigned int len;
+  int queue = 0;
+  int ret;
+
+  if (lower->txqueues > 1 && lower->ops->transmit_queue != NULL)
+    {
+      queue = netdev_lower_flowhash(pkt) % lower->txqueues;
+    }
+
+  /* The lower half owns the packet once it is accepted */
+
+  len = netpkt_getdatalen(lower, pkt);
+  if (lower->ops->transmit_queue != NULL)
+    {
+      ret = lower->ops->transmit_queue(lower, pkt, queue);
+    }
+  else
+    {
+      ret = lower->ops->transmit(lower, pkt);
+    }
+
+  stats = &lower->txstats[queue];
+  if (ret == OK)
+    {
+      stats->packets++;
+      stats->bytes += len;
+    }
+  else
+    {
+      stats->errors++;
+    }
+
+  return ret;
+#else
+  return lower->ops->transmit(lower, pkt);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_upper_receive
+ *
+ * Description:
+ *   Take a packet from one RX queue of the lower half.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR netpkt_t *netdev_upper_receive(FAR struct netdev_lowerhalf_s *lower,
+                                          int queue)
+{
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  FAR struct netdev_queue_stats_s *stats;
+  FAR netpkt_t *pkt;
+
+  if (lower->ops->receive_queue != NULL)
+    {
+      pkt = lower->ops->receive_queue(lower, queue);
+    }
+  else
+    {
+      pkt = lower->ops->receive(lower);
+    }
+
+  if (pkt != NULL)
+    {
+      stats = &lower->rxstats[queue];
+      stats->packets++;
+      stats->bytes += netpkt_getdatalen(lower, pkt);
+    }
+
+  return pkt;
+#else
+  UNUSED(queue);
+  return lower->ops->receive(lower);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_upper_tcpseq
+ *
+ * Description:
+ *   Return the sequence number of a TCP header.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_GSO) || defined(CONFIG_NETDEV_GRO)
+static inline uint32_t netdev_upper_tcpseq(FAR struct tcp_hdr_s *tcp)
+{
+  return ((uint32_t)tcp->seqno[0] << 24) | ((uint32_t)tcp->seqno[1] << 16) |
+         ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3];
+}
+
+/****************************************************************************
+ * Name: netdev_upper_tcpsum
+ *
+ * Description:
+ *   Return the one's complement sum of the IPv4 pseudo header and the TCP
+ *   header of a segment carrying 'paylen' bytes of payload whose own sum
+ *   is 'paysum'.
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_upper_tcpsum(FAR struct ipv4_hdr_s *ipv4,
+                                    FAR struct tcp_hdr_s *tcp,
+                                    unsigned int paylen, uint16_t paysum)
+{
+  unsigned int tcphdrlen = (tcp->tcpoffset >> 4) << 2;
+  uint32_t sum;
+
+  sum = chksum(tcphdrlen + paylen + IP_PROTO_TCP,
+               (FAR const uint8_t *)ipv4->srcipaddr,
+               2 * sizeof(in_addr_t));
+  sum = chksum(sum, (FAR const uint8_t *)tcp, tcphdrlen);
+  sum += paysum;
+
+  return (uint16_t)(sum + (sum >> 16));
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_gso
+ *
+ * Description:
+ *   Split an oversized IPv4 TCP packet, built by TCP because the device
+ *   advertises segmentation offload, into segments of d_gsomss payload
+ *   bytes and queue them for transmission.  The headers of the packet are
+ *   copied to every segment with the length, identification, sequence
+ *   number, flags and checksums adjusted.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *   pkt - The oversized packet, taken from the device
+ *
+ * Returned Value:
+ *   true if the packet was consumed; false if it is not a segmentation
+ *   offload packet.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+static bool netdev_upper_gso(FAR struct net_driver_s *dev,
+                             FAR netpkt_t *pkt)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp;
+  FAR struct iob_s *seg;
+  uint8_t llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iphdrlen;
+  unsigned int hdrlen;
+  unsigned int offset;
+  unsigned int paylen;
+  uint32_t seqno;
+  uint16_t ipid;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  uint16_t sum;
+#endif
+
+  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+  if (dev->d_gsomss == 0 || pkt->io_len < iphdrlen + TCP_HDRLEN ||
+      (ipv4->vhl & IP_VERSION_MASK) != IPv4_VERSION ||
+      ipv4->proto != IP_PROTO_TCP)
+    {
+      return false;
+    }
+
+  tcp    = (FAR struct tcp_hdr_s *)((FAR uint8_t *)ipv4 + iphdrlen);
+  hdrlen = iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+  if (pkt->io_len < hdrlen)
+    {
+      return false;
+    }
+
+  seqno  = netdev_upper_tcpseq(tcp);
+  ipid   = ((uint16_t)ipv4->ipid[0] << 8) | ipv4->ipid[1];
+
+  for (offset = hdrlen; offset < pkt->io_pktlen; offset += paylen)
+    {
+      FAR struct ipv4_hdr_s *sipv4;
+      FAR struct tcp_hdr_s *stcp;
+
+      paylen = MIN(dev->d_gsomss, pkt->io_pktlen - offset);
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          break;
+        }
+
+      /* Copy the link layer header in front of the data, then the IPv4
+       * and TCP headers and this segment's share of the payload.
+       */
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      memcpy(IOB_DATA(seg) - llhdrlen, IOB_DATA(pkt) - llhdrlen, llhdrlen);
+
+      if (iob_trycopyin(seg, (FAR const uint8_t *)ipv4, hdrlen, 0,
+                        false) != (int)hdrlen || seg->io_len < hdrlen ||
+          iob_clone_partial(pkt, paylen, offset, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      sipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(seg);
+      stcp  = (FAR struct tcp_hdr_s *)((FAR uint8_t *)sipv4 + iphdrlen);
+
+      sipv4->len[0]  = (hdrlen + paylen) >> 8;
+      sipv4->len[1]  = (hdrlen + paylen) & 0xff;
+      sipv4->ipid[0] = ipid >> 8;
+      sipv4->ipid[1] = ipid & 0xff;
+      ipid++;
+
+      sipv4->ipchksum = 0;
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      sipv4->ipchksum = ~ipv4_chksum(sipv4);
+#endif
+
+      stcp->seqno[0] = seqno >> 24;
+      stcp->seqno[1] = (seqno >> 16) & 0xff;
+      stcp->seqno[2] = (seqno >> 8) & 0xff;
+      stcp->seqno[3] = seqno & 0xff;
+      seqno         += paylen;
+
+      /* PSH and FIN belong to the last segment only */
+
+      if (offset + paylen < pkt->io_pktlen)
+        {
+          stcp->flags &= ~(TCP_PSH | TCP_FIN);
+        }
+
+      stcp->tcpchksum = 0;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      sum = netdev_upper_tcpsum(sipv4, stcp, paylen,
+                                chksum_iob(0, seg, hdrlen));
+      stcp->tcpchksum = ~((sum == 0) ? 0xffff : HTONS(sum));
+#endif
+
+      if (iob_tryadd_queue(seg, &upper->txq) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+    }
+
+  if (offset < pkt->io_pktlen)
+    {
+      /* The rest is lost, TCP will retransmit it */
+
+      nwarn("WARNING: Out of buffers segmenting %u byte packet\n",
+            pkt->io_pktlen);
+    }
+
+  netpkt_free(upper->lower, pkt, NETPKT_TX);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -285,21 +580,36 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
-  /* When packet sockets are enabled, feed the tx frame into it */
+  /* When packet sockets are enabled, feed the tx frame into it.  Packets
+   * that are segmented below are seen as their segments instead.
+   */
 
-  pkt_input(dev);
+#  ifdef CONFIG_NET_TCP_GSO
+  if (dev->d_len <= NETDEV_PKTSIZE(dev))
+#  endif
+    {
+      pkt_input(dev);
+    }
 #endif
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) <= NETDEV_PKTSIZE(dev))
     {
-      nerr("ERROR: Packet too long to send!\n");
-      ret = -EMSGSIZE;
+      ret = netdev_upper_transmit(lower, pkt);
     }
+#ifdef CONFIG_NET_TCP_GSO
+  else if (netdev_upper_gso(dev, pkt))
+    {
+      /* The segments are sent from the TX queue by the next poll */
+
+      return NETDEV_TX_CONTINUE;
+    }
+#endif
   else
     {
-      ret = lower->ops->transmit(lower, pkt);
+      nerr("ERROR: Packet too long to send!\n");
+      ret = -EMSGSIZE;
     }
 
   if (ret != OK)
@@ -584,105 +894,452 @@ static void ip_input(FAR struct net_driver_s *dev)
 #endif
 
 /****************************************************************************
- * Function: netdev_upper_rxpoll_work
+ * Function: netdev_upper_input
  *
  * Description:
- *   Try to receive packets from device and pass packets into IP
- *   stack and send packets which is from IP stack if necessary.
+ *   Pass one packet received from the lower half into the IP stack.
  *
  * Input Parameters:
- *   upper - Reference to the upper half driver structure
+ *   dev - Reference to the NuttX network driver state structure
+ *   pkt - The packet received from the lower half
  *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static void netdev_upper_input(FAR struct net_driver_s *dev,
+                               FAR netpkt_t *pkt)
 {
-  FAR struct netdev_lowerhalf_s *lower = upper->lower;
-  FAR struct net_driver_s       *dev   = &lower->netdev;
-  FAR netpkt_t                  *pkt;
-
-  /* Loop while receive() successfully retrieves valid Ethernet frames. */
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
 
-  while ((pkt = lower->ops->receive(lower)) != NULL)
+  if (!IFF_IS_UP(dev->d_flags))
     {
-      if (!IFF_IS_UP(dev->d_flags))
-        {
-          /* Interface down, drop frame */
+      /* Interface down, drop frame */
 
-          NETDEV_RXDROPPED(dev);
-          netpkt_free(lower, pkt, NETPKT_RX);
-          continue;
-        }
+      NETDEV_RXDROPPED(dev);
+      netpkt_free(upper->lower, pkt, NETPKT_RX);
+      return;
+    }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
-      NETDEV_RXPACKETS(dev);
+  netpkt_put(dev, pkt, NETPKT_RX);
+  NETDEV_RXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
+  /* When packet sockets are enabled, feed the frame into the tap */
 
-      pkt_input(dev);
+  pkt_input(dev);
 #endif
 
-      switch (dev->d_lltype)
-        {
+  switch (dev->d_lltype)
+    {
 #ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
+    case NET_LL_LOOPBACK:
 #endif
 #ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
+    case NET_LL_ETHERNET:
 #endif
 #ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
+    case NET_LL_IEEE80211:
 #endif
 #if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
     defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
+      eth_input(dev);
+      break;
 #endif
 #ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
 #endif
 #ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
 #endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_parse
+ *
+ * Description:
+ *   Check whether a received packet is an IPv4 TCP segment for this host
+ *   that may be coalesced: no IP options or fragmentation, only the ACK
+ *   and PSH flags set, payload present and headers contiguous in the
+ *   first buffer.
+ *
+ * Returned Value:
+ *   The length of the IPv4 and TCP headers, or zero if the packet can not
+ *   be coalesced.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GRO
+static unsigned int
+netdev_upper_gro_parse(FAR struct net_driver_s *dev, FAR netpkt_t *pkt,
+                       FAR struct ipv4_hdr_s **ipv4p,
+                       FAR struct tcp_hdr_s **tcpp)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR struct eth_hdr_s *eth;
+  FAR struct ipv4_hdr_s *ipv4;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  uint16_t ipoffset;
+  uint16_t totlen;
+
+  if (dev->d_lltype != NET_LL_ETHERNET ||
+      pkt->io_len < IPv4_HDRLEN + TCP_HDRLEN)
+    {
+      return 0;
+    }
+
+  eth      = (FAR struct eth_hdr_s *)netpkt_getdata(upper->lower, pkt);
+  ipv4     = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  ipoffset = ((uint16_t)ipv4->ipoffset[0] << 8) | ipv4->ipoffset[1];
+
+  if (eth->type != HTONS(ETHTYPE_IP) ||
+      ipv4->vhl != (IPv4_VERSION | (IPv4_HDRLEN >> 2)) ||
+      ipv4->proto != IP_PROTO_TCP ||
+      (ipoffset & ~IP_FLAG_DONTFRAG) != 0 ||
+      !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                        dev->d_ipaddr))
+    {
+      return 0;
+    }
+
+  /* Frames carrying link layer padding are left alone */
+
+  totlen = ((uint16_t)ipv4->len[0] << 8) | ipv4->len[1];
+  tcp    = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  hdrlen = IPv4_HDRLEN + ((tcp->tcpoffset >> 4) << 2);
+
+  if (totlen != pkt->io_pktlen || hdrlen < IPv4_HDRLEN + TCP_HDRLEN ||
+      hdrlen >= totlen || pkt->io_len < hdrlen ||
+      (tcp->flags & ~TCP_PSH) != TCP_ACK)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+  if (ipv4_chksum(ipv4) != 0xffff)
+    {
+      return 0;
+    }
+#endif
+
+  *ipv4p = ipv4;
+  *tcpp  = tcp;
+  return hdrlen;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_match
+ *
+ * Description:
+ *   Return true if a segment continues the held segment: same flow and
+ *   header fields, and the next sequence number.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_match(FAR struct netdev_upperhalf_s *upper,
+                                   FAR struct ipv4_hdr_s *ipv4,
+                                   FAR struct tcp_hdr_s *tcp,
+                                   unsigned int hdrlen, uint16_t paylen)
+{
+  FAR netpkt_t *held = upper->gro_pkt;
+  FAR struct ipv4_hdr_s *hipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(held);
+  FAR struct tcp_hdr_s *htcp = (FAR struct tcp_hdr_s *)(hipv4 + 1);
+
+  return netdev_upper_tcpseq(tcp) == upper->gro_seqno &&
+         held->io_pktlen + paylen <= CONFIG_NETDEV_GRO_MAXSIZE &&
+         hipv4->tos == ipv4->tos && hipv4->ttl == ipv4->ttl &&
+         memcmp(hipv4->srcipaddr, ipv4->srcipaddr,
+                2 * sizeof(in_addr_t)) == 0 &&
+         htcp->srcport == tcp->srcport && htcp->destport == tcp->destport &&
+         htcp->tcpoffset == tcp->tcpoffset &&
+         memcmp(htcp->ackno, tcp->ackno, sizeof(tcp->ackno)) == 0 &&
+         memcmp(htcp->wnd, tcp->wnd, sizeof(tcp->wnd)) == 0 &&
+         memcmp(htcp->optdata, tcp->optdata,
+                hdrlen - IPv4_HDRLEN - TCP_HDRLEN) == 0;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Pass the held segment, if any, into the IP stack.  If other segments
+ *   were appended to it, the IPv4 length and both checksums are updated
+ *   first.
+ *
+ *   The TCP checksum is computed from the payload sums of the coalesced
+ *   segments, which were in turn derived from their received checksums
+ *   rather than from their data.  A corrupted segment therefore still
+ *   makes the coalesced packet fail the check in tcp_input().
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR netpkt_t *pkt = upper->gro_pkt;
+  FAR struct ipv4_hdr_s *ipv4;
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t totlen;
+  uint16_t sum;
+
+  if (pkt == NULL)
+    {
+      return;
+    }
+
+  upper->gro_pkt = NULL;
+
+  ipv4   = (FAR struct ipv4_hdr_s *)IOB_DATA(pkt);
+  tcp    = (FAR struct tcp_hdr_s *)(ipv4 + 1);
+  totlen = ((uint16_t)ipv4->len[0] << 8) | ipv4->len[1];
+
+  if (totlen != pkt->io_pktlen)
+    {
+      ipv4->len[0]   = pkt->io_pktlen >> 8;
+      ipv4->len[1]   = pkt->io_pktlen & 0xff;
+      ipv4->ipchksum = 0;
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+#endif
+
+      tcp->tcpchksum = 0;
+      sum = netdev_upper_tcpsum(ipv4, tcp, upper->gro_paylen,
+                                upper->gro_paysum);
+      tcp->tcpchksum = ~((sum == 0) ? 0xffff : HTONS(sum));
+    }
+
+  netdev_upper_input(dev, pkt);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_input
+ *
+ * Description:
+ *   Coalesce a received packet with the held segment or pass it into the
+ *   IP stack.  netdev_upper_gro_flush() must be called before the network
+ *   is unlocked.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_input(FAR struct net_driver_s *dev,
+                                   FAR netpkt_t *pkt)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  FAR struct ipv4_hdr_s *ipv4;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  uint16_t paylen;
+  uint16_t paysum;
+  uint8_t flags;
+
+  hdrlen = netdev_upper_gro_parse(dev, pkt, &ipv4, &tcp);
+  if (hdrlen == 0)
+    {
+      netdev_upper_gro_flush(dev);
+      netdev_upper_input(dev, pkt);
+      return;
+    }
+
+  /* A segment with a valid checksum sums to 0xffff, so the sum of its
+   * payload is the complement of the sum of its headers.
+   */
+
+  paylen = pkt->io_pktlen - hdrlen;
+  paysum = ~netdev_upper_tcpsum(ipv4, tcp, paylen, 0);
+  flags  = tcp->flags;
+
+  if (upper->gro_pkt != NULL)
+    {
+      if (netdev_upper_gro_match(upper, ipv4, tcp, hdrlen, paylen))
+        {
+          FAR struct ipv4_hdr_s *hipv4 =
+            (FAR struct ipv4_hdr_s *)IOB_DATA(upper->gro_pkt);
+          FAR struct tcp_hdr_s *htcp = (FAR struct tcp_hdr_s *)(hipv4 + 1);
+
+          /* After an odd number of bytes the payload is summed with its
+           * bytes swapped.
+           */
+
+          if ((upper->gro_paylen & 1) != 0)
+            {
+              paysum = (paysum << 8) | (paysum >> 8);
+            }
+
+          paysum += upper->gro_paysum;
+          upper->gro_paysum = paysum < upper->gro_paysum ? paysum + 1 :
+                                                           paysum;
+          upper->gro_paylen += paylen;
+          upper->gro_seqno  += paylen;
+          htcp->flags       |= flags;
+
+          /* Only the payload is kept, the rest of the packet no longer
+           * counts against the lower half's quota.
+           */
+
+          NETDEV_RXPACKETS(dev);
+          atomic_fetch_add(&upper->lower->quota[NETPKT_RX], 1);
+          iob_concat(upper->gro_pkt, iob_trimhead(pkt, hdrlen));
+
+          if ((flags & TCP_PSH) != 0)
+            {
+              netdev_upper_gro_flush(dev);
+            }
+
+          return;
         }
+
+      netdev_upper_gro_flush(dev);
+    }
+
+  if ((flags & TCP_PSH) != 0)
+    {
+      /* Nothing is expected to follow */
+
+      netdev_upper_input(dev, pkt);
+      return;
     }
+
+  upper->gro_pkt    = pkt;
+  upper->gro_paylen = paylen;
+  upper->gro_paysum = paysum;
+  upper->gro_seqno  = netdev_upper_tcpseq(tcp) + paylen;
 }
+#else
+#  define netdev_upper_gro_input(dev, pkt) netdev_upper_input(dev, pkt)
+#  define netdev_upper_gro_flush(dev)
+#endif
 
 /****************************************************************************
- * Name: netdev_upper_work
+ * Function: netdev_upper_rxqueue_work
  *
  * Description:
- *   Perform an out-of-cycle poll on a dedicated thread or the worker thread.
+ *   Try to receive packets from one RX queue of the device and pass
+ *   packets into IP stack and send packets which is from IP stack if
+ *   necessary.
  *
  * Input Parameters:
- *   arg - Reference to the upper half driver structure (cast to void *)
+ *   upper - Reference to the upper half driver structure
+ *   queue - The RX queue to take packets from
+ *
+ * Assumptions:
+ *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_work(FAR void *arg)
+static void netdev_upper_rxqueue_work(FAR struct netdev_upperhalf_s *upper,
+                                      int queue)
 {
-  FAR struct netdev_upperhalf_s *upper = arg;
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR struct net_driver_s       *dev   = &lower->netdev;
+  FAR netpkt_t                  *pkt;
+
+  /* Loop while receive() successfully retrieves valid Ethernet frames. */
+
+  while ((pkt = netdev_upper_receive(lower, queue)) != NULL)
+    {
+      netdev_upper_gro_input(dev, pkt);
+    }
+
+  netdev_upper_gro_flush(dev);
+}
+
+/****************************************************************************
+ * Function: netdev_upper_rxpoll_work
+ *
+ * Description:
+ *   Receive from the RX queues steered to a work thread: queue N is served
+ *   by thread (N % NETDEV_THREAD_COUNT), a single queue by every thread.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   cpu   - Index of the work thread
+ *
+ * Assumptions:
+ *   The same as netdev_upper_rxqueue_work.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper,
+                                     int cpu)
+{
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  int queue;
+
+  if (lower->rxqueues > 1)
+    {
+      for (queue = cpu; queue < lower->rxqueues;
+           queue += NETDEV_THREAD_COUNT)
+        {
+          netdev_upper_rxqueue_work(upper, queue);
+        }
+
+      return;
+    }
+#else
+  UNUSED(cpu);
+#endif
+
+  netdev_upper_rxqueue_work(upper, 0);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_poll
+ *
+ * Description:
+ *   Perform an out-of-cycle poll on a dedicated thread or the worker thread.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   cpu   - Index of the work thread, 0 on the worker thread
+ *
+ ****************************************************************************/
 
+static void netdev_upper_poll(FAR struct netdev_upperhalf_s *upper, int cpu)
+{
   /* RX may release quota and driver buffer, so do RX first. */
 
   net_lock();
-  netdev_upper_rxpoll_work(upper);
+  netdev_upper_rxpoll_work(upper, cpu);
   netdev_upper_txavail_work(upper);
   net_unlock();
 }
 
+/****************************************************************************
+ * Name: netdev_upper_work
+ *
+ * Description:
+ *   Perform an out-of-cycle poll on the worker thread.
+ *
+ * Input Parameters:
+ *   arg - Reference to the upper half driver structure (cast to void *)
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETDEV_WORK_THREAD
+static void netdev_upper_work(FAR void *arg)
+{
+  netdev_upper_poll(arg, 0);
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wait
  *
@@ -729,7 +1386,7 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
   while (netdev_upper_wait(&upper->sem[cpu]) == OK &&
          upper->tid[cpu] != INVALID_PROCESS_ID)
     {
-      netdev_upper_work(upper);
+      netdev_upper_poll(upper, cpu);
     }
 
   nwarn("WARNING: Netdev work thread quitting.");
@@ -746,19 +1403,16 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
  *
  * Input Parameters:
  *   dev - Reference to the NuttX driver state structure
+ *   cpu - Index of the work thread to wake
  *
  ****************************************************************************/
 
-static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
+static inline void netdev_upper_queue_work_cpu(FAR struct net_driver_s *dev,
+                                               int cpu)
 {
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
 
 #ifdef CONFIG_NETDEV_WORK_THREAD
-#  ifdef CONFIG_NETDEV_RSS
-  int cpu = this_cpu();
-#  else
-  const int cpu = 0;
-#  endif
   int semcount;
 
   if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
@@ -773,6 +1427,17 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
 
       work_queue(NETDEV_WORK, &upper->work, netdev_upper_work, upper, 0);
     }
+
+  UNUSED(cpu);
+#endif
+}
+
+static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NETDEV_RSS
+  netdev_upper_queue_work_cpu(dev, this_cpu());
+#else
+  netdev_upper_queue_work_cpu(dev, 0);
 #endif
 }
 
@@ -1201,6 +1866,17 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
       return -EINVAL;
     }
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (dev->rxqueues > CONFIG_NETDEV_MAX_QUEUES ||
+      dev->txqueues > CONFIG_NETDEV_MAX_QUEUES ||
+      (dev->rxqueues > 1 && dev->ops->receive_queue == NULL) ||
+      (dev->txqueues > 1 && dev->ops->transmit_queue == NULL))
+    {
+      nerr("ERROR: Invalid queues %u/%u\n", dev->rxqueues, dev->txqueues);
+      return -EINVAL;
+    }
+#endif
+
   if ((upper = netdev_upper_alloc(dev)) == NULL)
     {
       return -ENOMEM;
@@ -1217,6 +1893,9 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
   dev->netdev.d_ioctl   = netdev_upper_ioctl;
 #endif
   dev->netdev.d_private = upper;
+#ifdef CONFIG_NET_TCP_GSO
+  dev->netdev.d_gsosize = CONFIG_NET_TCP_GSO_MAXSIZE;
+#endif
 
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
@@ -1350,6 +2029,124 @@ void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev)
 #endif
 }
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer that packets are ready to read on one
+ *   RX queue.  Only the thread the queue is steered to is woken.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The RX queue with packets ready
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue)
+{
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  if (dev->rxqueues > 1)
+    {
+      netdev_upper_queue_work_cpu(&dev->netdev,
+                                  queue % NETDEV_THREAD_COUNT);
+    }
+  else
+    {
+      netdev_upper_queue_work(&dev->netdev);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_lower_flowhash
+ *
+ * Description:
+ *   Hash the addresses and ports of an IPv4 or IPv6 packet, for lower
+ *   halves that spread received packets over their queues in software.
+ *   Both directions of a flow hash to the same value.
+ *
+ * Input Parameters:
+ *   pkt - The packet, as passed to transmit or returned by receive
+ *
+ * Returned Value:
+ *   The flow hash, 0 if the packet is not IP.
+ *
+ ****************************************************************************/
+
+uint32_t netdev_lower_flowhash(FAR netpkt_t *pkt)
+{
+  FAR const uint8_t *ip = IOB_DATA(pkt);
+  FAR const uint8_t *l4 = NULL;
+  uint32_t hash = 0;
+  uint8_t proto = 0;
+
+  if (pkt->io_len < 1)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION &&
+      pkt->io_len >= IPv4_HDRLEN)
+    {
+      FAR const struct ipv4_hdr_s *ipv4 =
+        (FAR const struct ipv4_hdr_s *)ip;
+      unsigned int hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+
+      hash  = net_ip4addr_conv32(ipv4->srcipaddr) ^
+              net_ip4addr_conv32(ipv4->destipaddr);
+      proto = ipv4->proto;
+
+      /* Only the first fragment carries the ports */
+
+      if ((ipv4->ipoffset[0] & 0x1f) == 0 && ipv4->ipoffset[1] == 0)
+        {
+          l4 = ip + hdrlen;
+        }
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION &&
+      pkt->io_len >= IPv6_HDRLEN)
+    {
+      FAR const struct ipv6_hdr_s *ipv6 =
+        (FAR const struct ipv6_hdr_s *)ip;
+      int i;
+
+      for (i = 0; i < 8; i++)
+        {
+          hash ^= (uint32_t)(ipv6->srcipaddr[i] ^ ipv6->destipaddr[i]) <<
+                  ((i & 1) << 4);
+        }
+
+      proto = ipv6->proto;
+      l4    = ip + IPv6_HDRLEN;
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  if (l4 != NULL && (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) &&
+      l4 + 4 <= ip + pkt->io_len)
+    {
+      hash ^= (((uint32_t)l4[0] << 8) | l4[1]) ^
+              (((uint32_t)l4[2] << 8) | l4[3]);
+    }
+
+  hash ^= proto;
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_txdone
  *
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/types.h>
 #include <sched.h>
 #include <fcntl.h>
@@ -36,10 +37,12 @@
 #include <inttypes.h>
 #include <poll.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/lib/math32.h>
 #include <nuttx/note/note_driver.h>
 #include <nuttx/note/noteram_driver.h>
 #include <nuttx/panic_notifier.h>
@@ -72,21 +75,60 @@
 #define get_task_state(s)                                                    \
   ((s) == 0 ? 'X' : ((s) <= LAST_READY_TO_RUN_STATE ? 'R' : 'S'))
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+/* Each CPU's ring indices are padded to their own cache line so that
+ * CPUs recording notes do not share a line.
+ */
+
+#  define NOTERAM_RING_ALIGN 64
+
+/* The size of each CPU's ring for a buffer of the given size */
+
+#  define NOTERAM_CPUSIZE(s) (1u << LOG2_FLOOR((s) / NCPUS))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+/* One CPU's ring.  The positions increase without wrapping at the ring
+ * size; the buffer index is the position modulo the ring size.  Head, tail
+ * and the clear acknowledgement are only written by the owning CPU, the
+ * rest only by readers.  A reader clears the ring by posting the position
+ * to clear up to and bumping nr_clearseq; the owner moves its tail there
+ * when it next adds a note.
+ */
+
+struct noteram_ring_s
+{
+  volatile uint32_t nr_head;     /* Position of the next note to add */
+  volatile uint32_t nr_tail;     /* Position of the oldest note */
+  volatile uint32_t nr_clearack; /* Last nr_clearseq applied by the owner */
+  volatile uint32_t nr_read;     /* Position of the next note to read */
+  volatile uint32_t nr_clear;    /* Position requested by the last clear */
+  volatile uint32_t nr_clearseq; /* Number of clear requests */
+  uint8_t nr_pad[NOTERAM_RING_ALIGN - 6 * sizeof(uint32_t)];
+};
+#endif
+
 struct noteram_driver_s
 {
   struct note_driver_s driver;
   FAR uint8_t *ni_buffer;
   size_t ni_bufsize;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  size_t ni_cpusize;
+#endif
   unsigned int ni_overwrite;
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
   volatile unsigned int ni_read;
   spinlock_t lock;
   FAR struct pollfd *pfd;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  struct noteram_ring_s ni_ring[NCPUS];
+#endif
 };
 
 /* The structure to hold the context data of trace dump */
@@ -176,6 +218,9 @@ struct noteram_driver_s g_noteram_driver =
   },
   g_ramnote_buffer,
   CONFIG_DRIVERS_NOTERAM_BUFSIZE,
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  NOTERAM_CPUSIZE(CONFIG_DRIVERS_NOTERAM_BUFSIZE),
+#endif
 #ifdef CONFIG_DRIVERS_NOTERAM_DEFAULT_NOOVERWRITE
   NOTERAM_MODE_OVERWRITE_DISABLE
 #else
@@ -203,8 +248,26 @@ struct noteram_driver_s g_noteram_driver =
 
 static void noteram_buffer_clear(FAR struct noteram_driver_s *drv)
 {
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  int cpu;
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      FAR struct noteram_ring_s *ring = &drv->ni_ring[cpu];
+
+      /* The tail belongs to the owning CPU, which may be adding a note
+       * right now.  Ask it to drop everything up to the current head.
+       */
+
+      ring->nr_clear = ring->nr_head;
+      SP_DMB();
+      ring->nr_clearseq++;
+      ring->nr_read = ring->nr_clear;
+    }
+#else
   drv->ni_tail = drv->ni_head;
   drv->ni_read = drv->ni_head;
+#endif
 
   if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
@@ -212,6 +275,176 @@ static void noteram_buffer_clear(FAR struct noteram_driver_s *drv)
     }
 }
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+/****************************************************************************
+ * Name: noteram_ring_copyout
+ *
+ * Description:
+ *   Copy 'len' bytes starting at position 'pos' out of a CPU's ring,
+ *   handling wraparound.
+ *
+ ****************************************************************************/
+
+static void noteram_ring_copyout(FAR struct noteram_driver_s *drv, int cpu,
+                                 uint32_t pos, FAR void *dest, size_t len)
+{
+  FAR const uint8_t *base = drv->ni_buffer + cpu * drv->ni_cpusize;
+  size_t index = pos & (drv->ni_cpusize - 1);
+  size_t space = MIN(drv->ni_cpusize - index, len);
+
+  memcpy(dest, base + index, space);
+  memcpy((FAR uint8_t *)dest + space, base, len - space);
+}
+
+/****************************************************************************
+ * Name: noteram_ring_oldest
+ *
+ * Description:
+ *   Position of the oldest note in a CPU's ring that has not been cleared.
+ *
+ ****************************************************************************/
+
+static uint32_t noteram_ring_oldest(FAR struct noteram_ring_s *ring)
+{
+  if (ring->nr_clearseq != ring->nr_clearack)
+    {
+      return ring->nr_clear;
+    }
+
+  return ring->nr_tail;
+}
+
+/****************************************************************************
+ * Name: noteram_unread_length
+ *
+ * Description:
+ *   Length of unread data currently in all of the rings.
+ *
+ ****************************************************************************/
+
+static unsigned int noteram_unread_length(FAR struct noteram_driver_s *drv)
+{
+  unsigned int length = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      FAR struct noteram_ring_s *ring = &drv->ni_ring[cpu];
+      uint32_t head = ring->nr_head;
+      uint32_t read = ring->nr_read;
+      uint32_t tail = ring->nr_tail;
+
+      if ((int32_t)(tail - read) > 0)
+        {
+          read = tail;
+        }
+
+      length += head - read;
+    }
+
+  return length;
+}
+
+/****************************************************************************
+ * Name: noteram_get
+ *
+ * Description:
+ *   Get the oldest unread note of all CPUs' rings.
+ *
+ *   The rings are written without taking any lock, so a note may be
+ *   overwritten by its CPU while it is being copied.  Writers publish the
+ *   new tail before they overwrite anything, so the copy is only valid if
+ *   the tail has not passed it afterwards; otherwise start over.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the next note
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the positive, non-zero length of the return note is
+ *   provided.  Zero is returned only if the rings are empty.  A negated
+ *   errno value is returned in the event of any failure.
+ *
+ * Assumptions:
+ *   Readers are serialized by the driver lock.
+ *
+ ****************************************************************************/
+
+static ssize_t noteram_get(FAR struct noteram_driver_s *drv,
+                           FAR uint8_t *buffer, size_t buflen)
+{
+  FAR struct noteram_ring_s *ring;
+  struct note_common_s note;
+  clock_t systime = 0;
+  ssize_t notelen = 0;
+  uint32_t read;
+  int found;
+  int cpu;
+
+  DEBUGASSERT(buffer != NULL);
+
+  do
+    {
+      /* Find the CPU whose next note is the oldest */
+
+      found = -1;
+      for (cpu = 0; cpu < NCPUS; cpu++)
+        {
+          ring = &drv->ni_ring[cpu];
+
+          /* Notes overwritten since the last read are lost */
+
+          if ((int32_t)(ring->nr_tail - ring->nr_read) > 0)
+            {
+              ring->nr_read = ring->nr_tail;
+            }
+
+          if (ring->nr_read == ring->nr_head)
+            {
+              continue;
+            }
+
+          SP_DSB();
+          noteram_ring_copyout(drv, cpu, ring->nr_read, &note,
+                               sizeof(note));
+          if (found < 0 || (sclock_t)(note.nc_systime - systime) < 0)
+            {
+              found   = cpu;
+              systime = note.nc_systime;
+              notelen = note.nc_length;
+            }
+        }
+
+      if (found < 0)
+        {
+          return 0;
+        }
+
+      ring = &drv->ni_ring[found];
+      read = ring->nr_read;
+
+      /* Is the user buffer large enough to hold the note? */
+
+      if (buflen < notelen)
+        {
+          /* Skip the large note so that we do not get constipated. */
+
+          ring->nr_read = read + NOTE_ALIGN(notelen);
+
+          /* and return an error */
+
+          return -EFBIG;
+        }
+
+      noteram_ring_copyout(drv, found, read, buffer, notelen);
+      SP_DSB();
+    }
+  while ((int32_t)(ring->nr_tail - read) > 0 || notelen == 0);
+
+  ring->nr_read = read + NOTE_ALIGN(notelen);
+  return notelen;
+}
+#else
 /****************************************************************************
  * Name: noteram_next
  *
@@ -420,6 +653,8 @@ static ssize_t noteram_get(FAR struct noteram_driver_s *drv,
   return notelen;
 }
 
+#endif /* CONFIG_DRIVERS_NOTERAM_PERCPU */
+
 /****************************************************************************
  * Name: noteram_open
  ****************************************************************************/
@@ -429,10 +664,21 @@ static int noteram_open(FAR struct file *filep)
   FAR struct noteram_dump_context_s *ctx;
   FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)
                                      filep->f_inode->i_private;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  int cpu;
+#endif
 
   /* Reset the read index of the circular buffer */
 
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      drv->ni_ring[cpu].nr_read = noteram_ring_oldest(&drv->ni_ring[cpu]);
+    }
+#else
   drv->ni_read = drv->ni_tail;
+#endif
+
   ctx = kmm_zalloc(sizeof(*ctx));
   if (ctx == NULL)
     {
@@ -670,6 +916,106 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: noteram_add
+ *
+ * Description:
+ *   Add the variable length note to the ring of the current CPU.  Only
+ *   this CPU ever writes to the ring, so masking the local interrupts is
+ *   enough to reserve the space; no lock is shared with other CPUs.
+ *
+ * Input Parameters:
+ *   note    - The note buffer
+ *   notelen - The buffer length
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+static void noteram_add(FAR struct note_driver_s *driver,
+                        FAR const void *note, size_t notelen)
+{
+  FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)driver;
+  FAR struct noteram_ring_s *ring;
+  FAR uint8_t *base;
+  size_t length = NOTE_ALIGN(notelen);
+  size_t mask = drv->ni_cpusize - 1;
+  size_t index;
+  size_t space;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t seq;
+  irqstate_t flags;
+  int cpu;
+
+  flags = up_irq_save();
+
+  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+    {
+      up_irq_restore(flags);
+      return;
+    }
+
+  DEBUGASSERT(note != NULL && notelen < drv->ni_cpusize);
+
+  cpu  = this_cpu();
+  ring = &drv->ni_ring[cpu];
+  base = drv->ni_buffer + cpu * drv->ni_cpusize;
+  head = ring->nr_head;
+  tail = ring->nr_tail;
+
+  /* Apply a clear requested by a reader since the last note */
+
+  seq = ring->nr_clearseq;
+  if (seq != ring->nr_clearack)
+    {
+      SP_DMB();
+      tail = ring->nr_clear;
+      ring->nr_tail = tail;
+      ring->nr_clearack = seq;
+    }
+
+  if (head - tail + length > drv->ni_cpusize)
+    {
+      if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+        {
+          /* Stop recording if not in overwrite mode */
+
+          drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          up_irq_restore(flags);
+          return;
+        }
+
+      /* Drop the oldest notes, and let readers know before their space is
+       * reused.
+       */
+
+      do
+        {
+          tail += NOTE_ALIGN(base[tail & mask]);
+        }
+      while (head - tail + length > drv->ni_cpusize);
+
+      ring->nr_tail = tail;
+      SP_DMB();
+    }
+
+  index = head & mask;
+  space = MIN(drv->ni_cpusize - index, notelen);
+  memcpy(base + index, note, space);
+  memcpy(base, (FAR const uint8_t *)note + space, notelen - space);
+
+  /* The note must be complete before it is published */
+
+  SP_DMB();
+  ring->nr_head = head + length;
+
+  up_irq_restore(flags);
+  poll_notify(&drv->pfd, 1, POLLIN);
+}
+#else
 /****************************************************************************
  * Name: noteram_add
  *
@@ -740,6 +1086,7 @@ static void noteram_add(FAR struct note_driver_s *driver,
   spin_unlock_irqrestore_wo_note(&drv->lock, flags);
   poll_notify(&drv->pfd, 1, POLLIN);
 }
+#endif
 
 /****************************************************************************
  * Name: noteram_dump_init_context
@@ -1374,6 +1721,10 @@ noteram_initialize(FAR const char *devpath, size_t bufsize, bool overwrite)
   drv->ni_tail = 0;
   drv->ni_read = 0;
   drv->pfd = NULL;
+#ifdef CONFIG_DRIVERS_NOTERAM_PERCPU
+  drv->ni_cpusize = NOTERAM_CPUSIZE(bufsize);
+  memset(drv->ni_ring, 0, sizeof(drv->ni_ring));
+#endif
 
   ret = note_driver_register(&drv->driver);
   if (ret < 0)
@@ -96,6 +96,8 @@ static void    uart_poll_notify(FAR uart_dev_t *dev, unsigned int min,
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch,
                                 bool oktoblock);
+static size_t  uart_putxmitbuf(FAR uart_dev_t *dev, FAR struct uio *uio,
+                               size_t len);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev,
                                     FAR const char *buffer,
                                     size_t buflen);
@@ -363,6 +365,75 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/****************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy up to 'len' bytes from 'uio' into the free space of the TX buffer
+ *   without any output processing.  At most two spans are copied: from the
+ *   head to the end of the buffer and then from the start of the buffer up
+ *   to the tail.  Never blocks.
+ *
+ * Returned Value:
+ *   The number of bytes copied; zero if the TX buffer is full.
+ *
+ ****************************************************************************/
+
+static size_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR struct uio *uio,
+                              size_t len)
+{
+  FAR struct uart_buffer_s *txbuf = &dev->xmit;
+  int16_t head = txbuf->head;
+  size_t nbytes = 0;
+  size_t span;
+  int16_t tail;
+
+  while (len > 0)
+    {
+      /* uart_xmitchars() may advance the tail asynchronously, which only
+       * ever frees more space than we see here.
+       */
+
+      tail = txbuf->tail;
+      if (tail > head)
+        {
+          span = tail - head - 1;
+        }
+      else if (tail == 0)
+        {
+          span = txbuf->size - head - 1;
+        }
+      else
+        {
+          span = txbuf->size - head;
+        }
+
+      if (span == 0)
+        {
+          break;
+        }
+
+      if (span > len)
+        {
+          span = len;
+        }
+
+      uio_copyto(uio, nbytes, &txbuf->buffer[head], span);
+      nbytes += span;
+      len    -= span;
+
+      head += span;
+      if (head >= txbuf->size)
+        {
+          head = 0;
+        }
+
+      txbuf->head = head;
+    }
+
+  return nbytes;
+}
+
 /****************************************************************************
  * Name: uart_putc
  ****************************************************************************/
@@ -906,6 +977,8 @@ static ssize_t uart_readv(FAR struct file *filep, FAR struct uio *uio)
   ssize_t recvd = 0;
   ssize_t buflen;
   bool echoed = false;
+  ssize_t nbytes;
+  int16_t head;
   int16_t tail;
   char ch;
   int ret;
@@ -959,8 +1032,35 @@ static ssize_t uart_readv(FAR struct file *filep, FAR struct uio *uio)
        */
 
       tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      head = rxbuf->head;
+      if (head != tail)
         {
+          /* Without input processing, line editing or echo, copy the
+           * contiguous span at the tail of the buffer as is.
+           */
+
+          if ((dev->tc_iflag & (INLCR | IGNCR | ICRNL)) == 0 &&
+              (dev->tc_lflag & (ICANON | ECHO)) == 0)
+            {
+              nbytes = head > tail ? head - tail : rxbuf->size - tail;
+              if (nbytes > buflen - recvd)
+                {
+                  nbytes = buflen - recvd;
+                }
+
+              uio_copyfrom(uio, recvd, &rxbuf->buffer[tail], nbytes);
+              recvd += nbytes;
+
+              tail += nbytes;
+              if (tail >= rxbuf->size)
+                {
+                  tail = 0;
+                }
+
+              rxbuf->tail = tail;
+              continue;
+            }
+
           /* Take the next character from the tail of the buffer */
 
           ch = rxbuf->buffer[tail];
@@ -1388,7 +1488,9 @@ static ssize_t uart_writev(FAR struct file *filep, FAR struct uio *uio)
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten;
   ssize_t           buflen;
+  size_t            nbytes;
   bool              oktoblock;
+  bool              bulk;
   int               ret;
   char              ch;
 
@@ -1454,14 +1556,33 @@ static ssize_t uart_writev(FAR struct file *filep, FAR struct uio *uio)
 
   oktoblock = ((filep->f_oflags & O_NONBLOCK) == 0);
 
+  /* Without any output processing the data can be copied as is */
+
+  bulk = (dev->tc_oflag & OPOST) == 0 ||
+         (dev->tc_oflag & (OCRNL | ONLCR | ONLRET)) == 0;
+
   /* Loop while we still have data to copy to the transmit buffer.
    * we add data to the head of the buffer; uart_xmitchars takes the
    * data from the end of the buffer.
    */
 
   uart_disabletxint(dev);
-  for (; buflen; uio_advance(uio, 1), buflen--)
+  for (; buflen; uio_advance(uio, nbytes), buflen -= nbytes)
     {
+      /* Copy whole spans while there is room in the TX buffer.  Once it
+       * is full, fall through and let uart_putxmitchar() wait for space.
+       */
+
+      if (bulk)
+        {
+          nbytes = uart_putxmitbuf(dev, uio, buflen);
+          if (nbytes > 0)
+            {
+              continue;
+            }
+        }
+
+      nbytes = 1;
       uio_copyto(uio, 0, &ch, 1);
       ret = OK;
 
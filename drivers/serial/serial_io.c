@@ -84,11 +84,17 @@ void uart_xmitchars(FAR uart_dev_t *dev)
           sent = uart_sendbuf(dev,
                               &dev->xmit.buffer[dev->xmit.tail],
                               sent);
-          if (sent > 0)
+          if (sent <= 0)
             {
-              dev->xmit.tail += sent;
-              nbytes += sent;
+              /* The lower half took nothing although it reported ready;
+               * leave the rest to the next TX interrupt.
+               */
+
+              break;
             }
+
+          dev->xmit.tail += sent;
+          nbytes += sent;
         }
       else
         {
@@ -238,7 +244,7 @@ void uart_recvchars(FAR uart_dev_t *dev)
           ret = uart_recvbuf(dev, pbuf, nbytes);
           if (ret <= 0)
             {
-              continue;
+              break;
             }
 
           nbytes = ret;
@@ -75,6 +75,8 @@ static void uart_ram_send(FAR struct uart_dev_s *dev, int ch);
 static void uart_ram_txint(FAR struct uart_dev_s *dev, bool enable);
 static bool uart_ram_txready(FAR struct uart_dev_s *dev);
 static bool uart_ram_txempty(FAR struct uart_dev_s *dev);
+static ssize_t uart_ram_sendbuf(FAR struct uart_dev_s *dev,
+                                FAR const void *buf, size_t len);
 
 static void uart_ram_wdog(wdparm_t arg);
 
@@ -103,6 +105,9 @@ static const struct uart_ops_s g_uart_ram_ops =
   uart_ram_txint,
   uart_ram_txready,
   uart_ram_txempty,
+  NULL,
+  NULL,
+  uart_ram_sendbuf,
 };
 
 #ifdef CONFIG_RAM_UART0
@@ -435,6 +440,73 @@ static bool uart_ram_txempty(FAR struct uart_dev_s *dev)
   return uart_rambuf_rxavailable(priv->tx) == 0;
 }
 
+/****************************************************************************
+ * Name: uart_ram_sendbuf
+ *
+ * Description:
+ *   Only used by the upper half for writes from interrupt context or the
+ *   IDLE task (e.g., the console), which bypass the DMA path.  Received
+ *   data always arrives through the RX DMA path, so there is no recvbuf.
+ *
+ ****************************************************************************/
+
+static ssize_t uart_ram_sendbuf(FAR struct uart_dev_s *dev,
+                                FAR const void *buf, size_t len)
+{
+  FAR struct uart_ram_s *priv = dev->priv;
+  FAR const char *src = buf;
+  size_t nbytes = 0;
+  size_t span;
+  int wroff;
+  int rdoff;
+
+  wroff = atomic_read(&priv->tx->wroff);
+  rdoff = atomic_read(&priv->tx->rdoff);
+
+  /* Copy at most two spans, leaving one byte free so that a full buffer
+   * can be told apart from an empty one.
+   */
+
+  while (len > 0)
+    {
+      if (rdoff > wroff)
+        {
+          span = rdoff - wroff - 1;
+        }
+      else if (rdoff == 0)
+        {
+          span = sizeof(priv->tx->buffer) - wroff - 1;
+        }
+      else
+        {
+          span = sizeof(priv->tx->buffer) - wroff;
+        }
+
+      if (span == 0)
+        {
+          break;
+        }
+
+      if (span > len)
+        {
+          span = len;
+        }
+
+      memcpy(&priv->tx->buffer[wroff], src + nbytes, span);
+      nbytes += span;
+      len    -= span;
+
+      wroff += span;
+      if (wroff >= sizeof(priv->tx->buffer))
+        {
+          wroff = 0;
+        }
+    }
+
+  atomic_set(&priv->tx->wroff, wroff);
+  return nbytes;
+}
+
 /****************************************************************************
  * Name: uart_ram_wdog
  ****************************************************************************/
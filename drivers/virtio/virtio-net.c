@@ -26,6 +26,7 @@
 
 #include <debug.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -45,6 +46,16 @@
 /* Virtio net feature bits */
 
 #define VIRTIO_NET_F_MAC      5
+#define VIRTIO_NET_F_CTRL_VQ  17
+#define VIRTIO_NET_F_MQ       22
+
+/* Virtio net control command to set the number of queue pairs in use */
+
+#define VIRTIO_NET_CTRL_MQ                 4
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET    0
+
+#define VIRTIO_NET_OK         0
+#define VIRTIO_NET_ERR        1
 
 /* Virtio net header size and packet buffer size */
 
@@ -52,12 +63,24 @@
 #define VIRTIO_NET_LLHDRSIZE  (sizeof(struct virtio_net_llhdr_s))
 #define VIRTIO_NET_BUFSIZE    (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE)
 
-/* Virtio net virtqueue index and number */
+/* Virtio net virtqueue index and number.  Queue pair N uses virtqueue
+ * 2N for RX and 2N + 1 for TX, the control virtqueue follows the last
+ * pair.
+ */
 
 #define VIRTIO_NET_RX         0
 #define VIRTIO_NET_TX         1
 #define VIRTIO_NET_NUM        2
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+#  define VIRTIO_NET_MAX_PAIRS CONFIG_NETDEV_MAX_QUEUES
+#else
+#  define VIRTIO_NET_MAX_PAIRS 1
+#endif
+
+#define VIRTIO_NET_VQ(pair, dir) ((pair) * VIRTIO_NET_NUM + (dir))
+#define VIRTIO_NET_MAX_VQS    (VIRTIO_NET_NUM * VIRTIO_NET_MAX_PAIRS + 1)
+
 #define VIRTIO_NET_MAX_PKT_SIZE \
     ((CONFIG_NET_LL_GUARDSIZE - ETH_HDRLEN) + VIRTIO_NET_BUFSIZE)
 #define VIRTIO_NET_MAX_NIOB \
@@ -99,6 +122,16 @@ begin_packed_struct struct virtio_net_config_s
   uint32_t supported_hash_types;
 } end_packed_struct;
 
+/* Virtio net control command, see virtio_net_setpairs() */
+
+begin_packed_struct struct virtio_net_ctrl_s
+{
+  uint8_t  class;                            /* VIRTIO_NET_CTRL_MQ */
+  uint8_t  cmd;                              /* VIRTIO_NET_CTRL_MQ_* */
+  uint16_t pairs;                            /* Queue pairs to use */
+  uint8_t  ack;                              /* Written by the device */
+} end_packed_struct;
+
 struct virtio_net_priv_s
 {
 #ifdef CONFIG_DRIVERS_WIFI_SIM
@@ -112,12 +145,14 @@ struct virtio_net_priv_s
   struct netdev_lowerhalf_s lower;     /* The netdev lowerhalf */
 #endif
 
-  spinlock_t                lock[VIRTIO_NET_NUM];
+  spinlock_t                lock[VIRTIO_NET_NUM * VIRTIO_NET_MAX_PAIRS];
 
   /* Virtio device information */
 
   FAR struct virtio_device *vdev;      /* Virtio device pointer */
-  int                       bufnum;    /* TX and RX Buffer number */
+  int                       bufnum;    /* Buffer number of each RX vq */
+  int                       txnum;     /* Total TX buffer number */
+  int                       npairs;    /* RX/TX queue pairs in use */
 };
 
 /* Virtio Link Layer Header, follow shows the iob buffer layout:
@@ -154,6 +189,12 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev);
 static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
                            FAR netpkt_t *pkt);
 static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+static int virtio_net_send_queue(FAR struct netdev_lowerhalf_s *dev,
+                                 FAR netpkt_t *pkt, int queue);
+static netpkt_t *virtio_net_recv_queue(FAR struct netdev_lowerhalf_s *dev,
+                                       int queue);
+#endif
 #ifdef CONFIG_NET_MCASTGROUP
 static int virtio_net_addmac(FAR struct netdev_lowerhalf_s *dev,
                              FAR const uint8_t *mac);
@@ -194,7 +235,11 @@ static const struct netdev_ops_s g_virtio_net_ops =
 #ifdef CONFIG_NETDEV_IOCTL
   virtio_net_ioctl,
 #endif
-  virtio_net_txfree
+  virtio_net_txfree,
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  virtio_net_send_queue,
+  virtio_net_recv_queue
+#endif
 };
 
 #ifdef CONFIG_DRIVERS_WIFI_SIM
@@ -266,7 +311,7 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
     }
 
   vrtinfo("Fill vq=%u, hdr=%p, count=%d\n", vq_id, hdr, iov_cnt);
-  if (vq_id == VIRTIO_NET_RX)
+  if (vq_id % VIRTIO_NET_NUM == VIRTIO_NET_RX)
     {
       return virtqueue_add_buffer_lock(vq, vb, 0, iov_cnt, hdr,
                                        &priv->lock[vq_id]);
@@ -282,10 +327,12 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
  * Name: virtio_net_rxfill
  ****************************************************************************/
 
-static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev,
+                              int pair)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
+  unsigned int vq_id = VIRTIO_NET_VQ(pair, VIRTIO_NET_RX);
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[vq_id].vq;
   FAR netpkt_t *pkt;
   int i;
 
@@ -310,14 +357,20 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
           break;
         }
 
-      /* Add buffer to RX virtqueue */
+      /* Add buffer to RX virtqueue, the RX quota is shared by all the
+       * queue pairs, so the ring may fill up before the quota runs out.
+       */
 
-      virtio_net_addbuffer(dev, vq, pkt, VIRTIO_NET_RX);
+      if (virtio_net_addbuffer(dev, vq, pkt, vq_id) < 0)
+        {
+          netpkt_free(dev, pkt, NETPKT_RX);
+          break;
+        }
     }
 
   if (i > 0)
     {
-      virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_RX]);
+      virtqueue_kick_lock(vq, &priv->lock[vq_id]);
     }
 }
 
@@ -325,18 +378,19 @@ static void virtio_net_rxfill(FAR struct netdev_lowerhalf_s *dev)
  * Name: virtio_net_txfree
  ****************************************************************************/
 
-static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
+static void virtio_net_txfree_pair(FAR struct netdev_lowerhalf_s *dev,
+                                   int pair)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
+  unsigned int vq_id = VIRTIO_NET_VQ(pair, VIRTIO_NET_TX);
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[vq_id].vq;
   FAR struct virtio_net_llhdr_s *hdr;
 
   while (1)
     {
       /* Get buffer from tx virtqueue */
 
-      hdr = virtqueue_get_buffer_lock(vq, NULL, NULL,
-                                      &priv->lock[VIRTIO_NET_TX]);
+      hdr = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock[vq_id]);
       if (hdr == NULL)
         {
           break;
@@ -347,6 +401,17 @@ static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
     }
 }
 
+static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
+{
+  FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
+  int i;
+
+  for (i = 0; i < priv->npairs; i++)
+    {
+      virtio_net_txfree_pair(dev, i);
+    }
+}
+
 /****************************************************************************
  * Name: virtio_net_ifup
  ****************************************************************************/
@@ -354,6 +419,8 @@ static void virtio_net_txfree(FAR struct netdev_lowerhalf_s *dev)
 static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
+  unsigned int vq_id;
+  int i;
 
 #ifdef CONFIG_NET_IPv4
   vrtinfo("Bringing up: %u.%u.%u.%u\n",
@@ -370,9 +437,13 @@ static int virtio_net_ifup(FAR struct netdev_lowerhalf_s *dev)
 
   /* Prepare interrupt and packets for receiving */
 
-  virtqueue_enable_cb_lock(priv->vdev->vrings_info[VIRTIO_NET_RX].vq,
-                           &priv->lock[VIRTIO_NET_RX]);
-  virtio_net_rxfill(dev);
+  for (i = 0; i < priv->npairs; i++)
+    {
+      vq_id = VIRTIO_NET_VQ(i, VIRTIO_NET_RX);
+      virtqueue_enable_cb_lock(priv->vdev->vrings_info[vq_id].vq,
+                               &priv->lock[vq_id]);
+      virtio_net_rxfill(dev, i);
+    }
 
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   if (priv->lower.wifi == NULL)
@@ -395,7 +466,7 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev)
 
   /* Disable the Ethernet interrupt */
 
-  for (i = 0; i < VIRTIO_NET_NUM; i++)
+  for (i = 0; i < VIRTIO_NET_NUM * priv->npairs; i++)
     {
       virtqueue_disable_cb_lock(priv->vdev->vrings_info[i].vq,
                                 &priv->lock[i]);
@@ -415,14 +486,16 @@ static int virtio_net_ifdown(FAR struct netdev_lowerhalf_s *dev)
 }
 
 /****************************************************************************
- * Name: virtio_net_send
+ * Name: virtio_net_send_queue
  ****************************************************************************/
 
-static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
-                           FAR netpkt_t *pkt)
+static int virtio_net_send_queue(FAR struct netdev_lowerhalf_s *dev,
+                                 FAR netpkt_t *pkt, int queue)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_TX].vq;
+  unsigned int vq_id = VIRTIO_NET_VQ(queue, VIRTIO_NET_TX);
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[vq_id].vq;
+  int ret;
 
   /* Check the send length */
 
@@ -434,56 +507,73 @@ static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
 
   /* Add buffer to vq and notify the other side */
 
-  virtio_net_addbuffer(dev, vq, pkt, VIRTIO_NET_TX);
-  virtqueue_kick_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+  ret = virtio_net_addbuffer(dev, vq, pkt, vq_id);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  virtqueue_kick_lock(vq, &priv->lock[vq_id]);
 
   /* Try return Netpkt TX buffer to upper-half. */
 
-  virtio_net_txfree(dev);
+  virtio_net_txfree_pair(dev, queue);
 
   /* If we have no buffer left, enable TX done callback. */
 
   if (netdev_lower_quota_load(dev, NETPKT_TX) <= 0)
     {
-      virtqueue_enable_cb_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+      virtqueue_enable_cb_lock(vq, &priv->lock[vq_id]);
     }
 
   return OK;
 }
 
 /****************************************************************************
- * Name: virtio_net_recv
+ * Name: virtio_net_send
  ****************************************************************************/
 
-static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
+static int virtio_net_send(FAR struct netdev_lowerhalf_s *dev,
+                           FAR netpkt_t *pkt)
+{
+  return virtio_net_send_queue(dev, pkt, 0);
+}
+
+/****************************************************************************
+ * Name: virtio_net_recv_queue
+ ****************************************************************************/
+
+static netpkt_t *virtio_net_recv_queue(FAR struct netdev_lowerhalf_s *dev,
+                                       int queue)
 {
   FAR struct virtio_net_priv_s *priv = (FAR struct virtio_net_priv_s *)dev;
-  FAR struct virtqueue *vq = priv->vdev->vrings_info[VIRTIO_NET_RX].vq;
+  unsigned int vq_id = VIRTIO_NET_VQ(queue, VIRTIO_NET_RX);
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[vq_id].vq;
   FAR struct virtio_net_llhdr_s *hdr;
   irqstate_t flags;
   uint32_t len;
 
   /* Fill the free Netpkt RX buffer to the RX virtqueue */
 
-  virtio_net_rxfill(dev);
+  virtio_net_rxfill(dev, queue);
 
   /* Get received buffer form RX virtqueue */
 
-  flags = spin_lock_irqsave(&priv->lock[VIRTIO_NET_RX]);
+  flags = spin_lock_irqsave(&priv->lock[vq_id]);
   hdr = virtqueue_get_buffer(vq, &len, NULL);
   if (hdr == NULL)
     {
       /* If we have no buffer left, enable RX callback. */
 
       virtqueue_enable_cb(vq);
-      spin_unlock_irqrestore(&priv->lock[VIRTIO_NET_RX], flags);
+      spin_unlock_irqrestore(&priv->lock[vq_id], flags);
 
       vrtinfo("get NULL buffer\n");
       return NULL;
     }
   else
     {
-      spin_unlock_irqrestore(&priv->lock[VIRTIO_NET_RX], flags);
+      spin_unlock_irqrestore(&priv->lock[vq_id], flags);
     }
 
   /* Set the received pkt length */
@@ -493,6 +583,15 @@ static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
   return hdr->pkt;
 }
 
+/****************************************************************************
+ * Name: virtio_net_recv
+ ****************************************************************************/
+
+static netpkt_t *virtio_net_recv(FAR struct netdev_lowerhalf_s *dev)
+{
+  return virtio_net_recv_queue(dev, 0);
+}
+
 #ifdef CONFIG_NET_MCASTGROUP
 /****************************************************************************
  * Name: virtio_net_addmac
@@ -535,8 +634,13 @@ static void virtio_net_rxready(FAR struct virtqueue *vq)
 {
   FAR struct virtio_net_priv_s *priv = vq->vq_dev->priv;
 
-  virtqueue_disable_cb_lock(vq, &priv->lock[VIRTIO_NET_RX]);
+  virtqueue_disable_cb_lock(vq, &priv->lock[vq->vq_queue_index]);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev_lower_rxready_queue((FAR struct netdev_lowerhalf_s *)priv,
+                             vq->vq_queue_index / VIRTIO_NET_NUM);
+#else
   netdev_lower_rxready((FAR struct netdev_lowerhalf_s *)priv);
+#endif
 }
 
 /****************************************************************************
@@ -547,10 +651,100 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
 {
   FAR struct virtio_net_priv_s *priv = vq->vq_dev->priv;
 
-  virtqueue_disable_cb_lock(vq, &priv->lock[VIRTIO_NET_TX]);
+  virtqueue_disable_cb_lock(vq, &priv->lock[vq->vq_queue_index]);
   netdev_lower_txdone((FAR struct netdev_lowerhalf_s *)priv);
 }
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+/****************************************************************************
+ * Name: virtio_net_getpairs
+ *
+ * Description:
+ *   Return the number of queue pairs to use.  The control virtqueue comes
+ *   after all the pairs the device has, so a device with more pairs than
+ *   NETDEV_MAX_QUEUES is driven with a single pair and without the
+ *   multi-queue feature.
+ *
+ ****************************************************************************/
+
+static int virtio_net_getpairs(FAR struct virtio_net_priv_s *priv)
+{
+  FAR struct virtio_device *vdev = priv->vdev;
+  uint16_t pairs = 1;
+
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_MQ) &&
+      virtio_has_feature(vdev, VIRTIO_NET_F_CTRL_VQ))
+    {
+      virtio_read_config_member(vdev, struct virtio_net_config_s,
+                                max_virtqueue_pairs, &pairs);
+    }
+
+  if (pairs > 1 && pairs <= VIRTIO_NET_MAX_PAIRS)
+    {
+      return pairs;
+    }
+
+  if (pairs > 1)
+    {
+      vrtwarn("%u queue pairs exceed NETDEV_MAX_QUEUES, use one\n", pairs);
+    }
+
+  virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+                                  (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
+  return 1;
+}
+
+/****************************************************************************
+ * Name: virtio_net_setpairs
+ *
+ * Description:
+ *   Tell the device how many queue pairs to use through the control
+ *   virtqueue.  Called once, before the interface is brought up, so the
+ *   command is simply polled for completion.
+ *
+ ****************************************************************************/
+
+static int virtio_net_setpairs(FAR struct virtio_net_priv_s *priv)
+{
+  FAR struct virtio_device *vdev = priv->vdev;
+  FAR struct virtqueue *vq =
+    vdev->vrings_info[VIRTIO_NET_NUM * priv->npairs].vq;
+  FAR struct virtio_net_ctrl_s *ctrl;
+  struct virtqueue_buf vb[3];
+  int ret;
+
+  ctrl = virtio_zalloc_buf(vdev, sizeof(*ctrl), 16);
+  if (ctrl == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ctrl->class = VIRTIO_NET_CTRL_MQ;
+  ctrl->cmd   = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+  ctrl->pairs = priv->npairs;
+  ctrl->ack   = VIRTIO_NET_ERR;
+
+  vb[0].buf = &ctrl->class;
+  vb[0].len = 2;
+  vb[1].buf = &ctrl->pairs;
+  vb[1].len = sizeof(ctrl->pairs);
+  vb[2].buf = &ctrl->ack;
+  vb[2].len = sizeof(ctrl->ack);
+
+  ret = virtqueue_add_buffer(vq, vb, 2, 1, ctrl);
+  if (ret >= 0)
+    {
+      virtqueue_kick(vq);
+      while (virtqueue_get_buffer(vq, NULL, NULL) == NULL);
+
+      ret = ctrl->ack == VIRTIO_NET_OK ? OK : -EIO;
+    }
+
+  virtio_free_buf(vdev, ctrl);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_net_init
  ****************************************************************************/
@@ -558,28 +752,56 @@ static void virtio_net_txdone(FAR struct virtqueue *vq)
 static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
                            FAR struct virtio_device *vdev)
 {
-  FAR const char *vqnames[VIRTIO_NET_NUM];
-  vq_callback callbacks[VIRTIO_NET_NUM];
+  FAR const char *vqnames[VIRTIO_NET_MAX_VQS];
+  vq_callback callbacks[VIRTIO_NET_MAX_VQS];
+  unsigned int txcap;
+  unsigned int rx;
+  unsigned int tx;
+  int nvqs;
   int ret;
+  int i;
 
-  spin_lock_init(&priv->lock[VIRTIO_NET_RX]);
-  spin_lock_init(&priv->lock[VIRTIO_NET_TX]);
   priv->vdev = vdev;
   vdev->priv = priv;
 
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
+#ifdef CONFIG_NETDEV_MULTIQUEUE
   virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+                                  (1UL << VIRTIO_NET_F_CTRL_VQ) |
+                                  (1UL << VIRTIO_NET_F_MQ) |
                                   (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
+  priv->npairs = virtio_net_getpairs(priv);
+#else
+  virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+                                  (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
+  priv->npairs = 1;
+#endif
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
-  vqnames[VIRTIO_NET_RX]   = "virtio_net_rx";
-  vqnames[VIRTIO_NET_TX]   = "virtio_net_tx";
-  callbacks[VIRTIO_NET_RX] = virtio_net_rxready;
-  callbacks[VIRTIO_NET_TX] = virtio_net_txdone;
-  ret = virtio_create_virtqueues(vdev, 0, VIRTIO_NET_NUM, vqnames,
-                                 callbacks, NULL);
+  for (i = 0; i < priv->npairs; i++)
+    {
+      rx = VIRTIO_NET_VQ(i, VIRTIO_NET_RX);
+      tx = VIRTIO_NET_VQ(i, VIRTIO_NET_TX);
+
+      spin_lock_init(&priv->lock[rx]);
+      spin_lock_init(&priv->lock[tx]);
+      vqnames[rx]   = "virtio_net_rx";
+      vqnames[tx]   = "virtio_net_tx";
+      callbacks[rx] = virtio_net_rxready;
+      callbacks[tx] = virtio_net_txdone;
+    }
+
+  nvqs = VIRTIO_NET_NUM * priv->npairs;
+  if (priv->npairs > 1)
+    {
+      vqnames[nvqs]   = "virtio_net_ctrl";
+      callbacks[nvqs] = NULL;
+      nvqs++;
+    }
+
+  ret = virtio_create_virtqueues(vdev, 0, nvqs, vqnames, callbacks, NULL);
   if (ret < 0)
     {
       vrterr("virtio_device_create_virtqueue failed, ret=%d\n", ret);
@@ -588,19 +810,48 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
 
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  if (priv->npairs > 1)
+    {
+      ret = virtio_net_setpairs(priv);
+      if (ret < 0)
+        {
+          vrtwarn("Failed to use %d queue pairs, ret=%d\n",
+                  priv->npairs, ret);
+          priv->npairs = 1;
+        }
+    }
+#endif
+
 #if CONFIG_DRIVERS_VIRTIO_NET_BUFNUM > 0
   priv->bufnum = CONFIG_DRIVERS_VIRTIO_NET_BUFNUM;
 #else
   /* Calculate the virtio network buffer number:
-   * 1/4 for the TX netpkts, 1/4 for the RX netpkts.
+   * 1/4 for the TX netpkts, 1/4 for the RX netpkts, the RX netpkts are
+   * split over the RX virtqueues.
    */
 
-  priv->bufnum = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4;
+  priv->bufnum = CONFIG_IOB_NBUFFERS / VIRTIO_NET_MAX_NIOB / 4 /
+                 priv->npairs;
 #endif
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_RX].info.num_descs /
-                     (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
-  priv->bufnum = MIN(vdev->vrings_info[VIRTIO_NET_TX].info.num_descs /
-                     (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
+
+  /* A flow always hashes to the same TX virtqueue, so each TX ring must
+   * be able to hold all the TX netpkts.
+   */
+
+  txcap = UINT_MAX;
+  for (i = 0; i < priv->npairs; i++)
+    {
+      rx = VIRTIO_NET_VQ(i, VIRTIO_NET_RX);
+      tx = VIRTIO_NET_VQ(i, VIRTIO_NET_TX);
+
+      priv->bufnum = MIN(vdev->vrings_info[rx].info.num_descs /
+                         (VIRTIO_NET_MAX_NIOB + 1), priv->bufnum);
+      txcap = MIN(vdev->vrings_info[tx].info.num_descs /
+                  (VIRTIO_NET_MAX_NIOB + 1), txcap);
+    }
+
+  priv->txnum = MIN(priv->bufnum * priv->npairs, txcap);
   return OK;
 }
 
@@ -668,9 +919,13 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
   /* Initialize the netdev lower half */
 
   netdev = (FAR struct netdev_lowerhalf_s *)priv;
-  netdev->quota[NETPKT_RX] = priv->bufnum;
-  netdev->quota[NETPKT_TX] = priv->bufnum;
+  netdev->quota[NETPKT_RX] = priv->bufnum * priv->npairs;
+  netdev->quota[NETPKT_TX] = priv->txnum;
   netdev->ops = &g_virtio_net_ops;
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  netdev->rxqueues = priv->npairs;
+  netdev->txqueues = priv->npairs;
+#endif
 
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   /* If the WiFi interfaces has reached the setting value,
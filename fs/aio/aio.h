@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <string.h>
 #include <aio.h>
 
@@ -58,13 +59,21 @@
  */
 
 struct file;
+struct aio_container_s;
+
+/* Performs the I/O of one request, returning the aio_result value */
+
+typedef CODE ssize_t (*aio_io_t)(FAR struct aio_container_s *aioc);
+
 struct aio_container_s
 {
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
+  dq_entry_t aioc_qlink;           /* Link in the submission queue */
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
-  struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  aio_io_t aioc_io;                /* Performs the I/O */
   pid_t aioc_pid;                  /* ID of the waiting task */
+  bool aioc_queued;                /* In the submission queue */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
 #endif
@@ -89,6 +98,12 @@ extern "C"
 
 EXTERN dq_queue_t g_aio_pending;
 
+/* This is the list of submitted I/O not yet started by a worker, in
+ * submission order.  Protected by the same lock.
+ */
+
+EXTERN dq_queue_t g_aio_submit;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -149,6 +164,16 @@ void aio_unlock(void);
 
 FAR struct aio_container_s *aioc_alloc(void);
 
+/****************************************************************************
+ * Name: aioc_navail
+ *
+ * Description:
+ *   Return the number of free AIO containers.
+ *
+ ****************************************************************************/
+
+int aioc_navail(void);
+
 /****************************************************************************
  * Name: aioc_free
  *
@@ -202,15 +227,60 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp);
 
 FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
+/****************************************************************************
+ * Name: aio_read_prepare/aio_write_prepare
+ *
+ * Description:
+ *   Check a read/write request and put it in a container, with aioc_io
+ *   set, ready for aio_queue() or aio_queue_list().
+ *
+ * Input Parameters:
+ *   aiocbp - The AIO control block pointer
+ *   aiocp  - Location to return the container
+ *
+ * Returned Value:
+ *   One if the container was returned in 'aiocp'; zero if the request
+ *   already has its final aio_result (e.g. -EBADF); otherwise a negated
+ *   errno value if the request could not be submitted.
+ *
+ ****************************************************************************/
+
+int aio_read_prepare(FAR struct aiocb *aiocbp,
+                     FAR struct aio_container_s **aiocp);
+int aio_write_prepare(FAR struct aiocb *aiocbp,
+                      FAR struct aio_container_s **aiocp);
+
+/****************************************************************************
+ * Name: aio_tryio
+ *
+ * Description:
+ *   If the file is non-blocking, perform the I/O on the caller's thread.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container, with aioc_io set
+ *
+ * Returned Value:
+ *   true if the request completed (and the container was released); false
+ *   if it has to be queued.
+ *
+ ****************************************************************************/
+
+bool aio_tryio(FAR struct aio_container_s *aioc);
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Submit the asynchronous I/O.  If 'nowait' is set and the file is
+ *   non-blocking the I/O is first tried on the caller's thread and
+ *   completes there unless it returns -EAGAIN.  Otherwise the container is
+ *   appended to the submission queue, drained in order by the low priority
+ *   work queue.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO container, as returned by aio_contain()
+ *   io     - Performs the I/O of the request
+ *   nowait - The I/O may be tried without waiting (read and write)
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -218,7 +288,46 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
+int aio_queue(FAR struct aio_container_s *aioc, aio_io_t io, bool nowait);
+
+/****************************************************************************
+ * Name: aio_queue_list
+ *
+ * Description:
+ *   Append a batch of containers, linked through aioc_qlink in 'list', to
+ *   the submission queue under a single lock, with at most one worker
+ *   wakeup for the whole batch.
+ *
+ * Input Parameters:
+ *   list - The containers to submit, with aioc_io set.  The list is empty
+ *          on success and unchanged on failure.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int aio_queue_list(FAR dq_queue_t *list);
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a container from the submission queue if no worker has started
+ *   its I/O yet.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container
+ *
+ * Returned Value:
+ *   true if the container was removed; false if its I/O has started.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+bool aio_dequeue(FAR struct aio_container_s *aioc);
 
 /****************************************************************************
  * Name: aio_signal
@@ -92,7 +92,6 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
   FAR struct aio_container_s *aioc;
   FAR struct aio_container_s *next;
   pid_t pid;
-  int status;
   int ret;
 
   /* Check if a non-NULL aiocbp was provided */
@@ -126,13 +125,11 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * and is still in the submission queue.  Only the second
+               * case can be canceled.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
-              if (status >= 0)
+              if (aio_dequeue(aioc))
                 {
                   /* Remove the container from the list of pending
                    * transfers
@@ -183,13 +180,11 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
               /* Yes... attempt to cancel the I/O.  There are two
                * possibilities:* (1) the work has already been started and
                * is no longer queued, or (2) the work has not been started
-               * and is still in the work queue.  Only the second case can
-               * be canceled.  work_cancel() will return -ENOENT in the
-               * first case.
+               * and is still in the submission queue.  Only the second
+               * case can be canceled.
                */
 
-              status = work_cancel(LPWORK, &aioc->aioc_work);
-              if (status >= 0)
+              if (aio_dequeue(aioc))
                 {
                   /* Remove the container from the list of pending
                    * transfers
@@ -44,65 +44,33 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: aio_fsync_worker
+ * Name: aio_fsync_io
  *
  * Description:
- *   This function executes on the worker thread and performs the
- *   asynchronous I/O operation.
+ *   This function performs the asynchronous fsync operation.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc - The AIO container of the request
  *
  * Returned Value:
- *   None
+ *   Zero (OK) on success or a negated errno value.
  *
  ****************************************************************************/
 
-static void aio_fsync_worker(FAR void *arg)
+static ssize_t aio_fsync_io(FAR struct aio_container_s *aioc)
 {
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
   int ret;
 
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
   /* Perform the fsync using aioc_filep */
 
   ret = file_fsync(aioc->aioc_filep);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
-      aiocbp->aio_result = ret;
-    }
-  else
-    {
-      aiocbp->aio_result = OK;
+      return ret;
     }
 
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  return OK;
 }
 
 /****************************************************************************
@@ -222,7 +190,7 @@ int aio_fsync(int op, FAR struct aiocb *aiocbp)
 
   /* Defer the work to the worker thread */
 
-  ret = aio_queue(aioc, aio_fsync_worker);
+  ret = aio_queue(aioc, aio_fsync_io, false);
   if (ret < 0)
     {
       /* The result and the errno have already been set */
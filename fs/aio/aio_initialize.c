@@ -70,6 +70,12 @@ static rmutex_t g_aio_lock = NXRMUTEX_INITIALIZER;
 
 dq_queue_t g_aio_pending;
 
+/* This is the list of submitted I/O not yet started by a worker, in
+ * submission order.  Protected by the same lock.
+ */
+
+dq_queue_t g_aio_submit;
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -174,6 +180,27 @@ FAR struct aio_container_s *aioc_alloc(void)
   return aioc;
 }
 
+/****************************************************************************
+ * Name: aioc_navail
+ *
+ * Description:
+ *   Return the number of free AIO containers, i.e. whether aioc_alloc()
+ *   would return without waiting.
+ *
+ ****************************************************************************/
+
+int aioc_navail(void)
+{
+  int sval;
+
+  if (nxsem_get_value(&g_aioc_freesem, &sval) < 0 || sval < 0)
+    {
+      return 0;
+    }
+
+  return sval;
+}
+
 /****************************************************************************
  * Name: aioc_free
  *
@@ -30,27 +30,206 @@
 #include <aio.h>
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/wqueue.h>
 
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Drains the submission queue.  There is at most one pending instance;
+ * while it runs it may be queued again, so that several low priority
+ * worker threads can drain the queue at the same time.
+ */
+
+static struct work_s g_aio_work;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Record the result of an I/O, release its container and signal the
+ *   client.
+ *
+ ****************************************************************************/
+
+static void aio_complete(FAR struct aio_container_s *aioc, ssize_t result)
+{
+  FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+  pid_t pid = aioc->aioc_pid;
+
+  aioc_decant(aioc);
+  aiocbp->aio_result = result;
+
+  /* Signal the client */
+
+  aio_signal(pid, aiocbp);
+}
+
+/****************************************************************************
+ * Name: aio_worker
+ *
+ * Description:
+ *   This function executes on the worker thread and performs the queued
+ *   asynchronous I/O operations in submission order until the queue is
+ *   empty.
+ *
+ * Input Parameters:
+ *   arg - Not used
+ *
+ ****************************************************************************/
+
+static void aio_worker(FAR void *arg)
+{
+  FAR struct aio_container_s *aioc;
+  FAR dq_entry_t *entry;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  uint8_t prio;
+#endif
+
+  UNUSED(arg);
+
+  while (aio_lock() >= 0)
+    {
+      entry = dq_remfirst(&g_aio_submit);
+      if (entry == NULL)
+        {
+          aio_unlock();
+          break;
+        }
+
+      aioc = container_of(entry, struct aio_container_s, aioc_qlink);
+
+      aioc->aioc_queued = false;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      prio = aioc->aioc_prio;
+#endif
+      aio_unlock();
+
+      aio_complete(aioc, aioc->aioc_io(aioc));
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Restore the low priority worker thread default priority */
+
+      lpwork_restorepriority(prio);
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: aio_enqueue
+ *
+ * Description:
+ *   Append a container to the submission queue.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock and, with priority inheritance, has
+ *   locked the scheduler.
+ *
+ ****************************************************************************/
+
+static void aio_enqueue(FAR struct aio_container_s *aioc)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* Make sure that the low-priority worker thread is running at at least
+   * the priority specified for this action.
+   */
+
+  lpwork_boostpriority(aioc->aioc_prio);
+#endif
+
+  dq_addlast(&aioc->aioc_qlink, &g_aio_submit);
+  aioc->aioc_queued = true;
+}
+
+/****************************************************************************
+ * Name: aio_kick
+ *
+ * Description:
+ *   Make sure that a drain of the submission queue is pending.  A drain
+ *   that is queued but not yet running will pick up everything submitted
+ *   before it runs.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+static int aio_kick(void)
+{
+  if (work_available(&g_aio_work))
+    {
+      return work_queue(LPWORK, &g_aio_work, aio_worker, NULL, 0);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_tryio
+ *
+ * Description:
+ *   If the file is non-blocking, perform the I/O on the caller's thread.
+ *   It completes there whenever the file has data or space ready.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container, with aioc_io set
+ *
+ * Returned Value:
+ *   true if the request completed (and the container was released); false
+ *   if it has to be queued.
+ *
+ ****************************************************************************/
+
+bool aio_tryio(FAR struct aio_container_s *aioc)
+{
+  ssize_t result;
+
+  if ((aioc->aioc_filep->f_oflags & O_NONBLOCK) == 0)
+    {
+      return false;
+    }
+
+  result = aioc->aioc_io(aioc);
+  if (result == -EAGAIN)
+    {
+      return false;
+    }
+
+  aio_complete(aioc, result);
+  return true;
+}
+
 /****************************************************************************
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Submit the asynchronous I/O.  If 'nowait' is set and the file is
+ *   non-blocking the I/O is first tried on the caller's thread and
+ *   completes there unless it returns -EAGAIN.  Otherwise the container is
+ *   appended to the submission queue, drained in order by the low priority
+ *   work queue.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO container, as returned by aio_contain()
+ *   io     - Performs the I/O of the request
+ *   nowait - The I/O may be tried without waiting (read and write)
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -58,44 +237,141 @@
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+int aio_queue(FAR struct aio_container_s *aioc, aio_io_t io, bool nowait)
 {
   int ret;
 
+  aioc->aioc_io = io;
+  if (nowait && aio_tryio(aioc))
+    {
+      return OK;
+    }
+
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Prohibit context switches until we complete the queuing */
 
   sched_lock();
+#endif
 
-  /* Make sure that the low-priority worker thread is running at at least
-   * the priority specified for this action.
-   */
+  aio_enqueue(aioc);
+  ret = aio_kick();
+  if (ret < 0)
+    {
+      aio_dequeue(aioc);
+    }
 
-  lpwork_boostpriority(aioc->aioc_prio);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* Now the low-priority work queue might run at its new priority */
+
+  sched_unlock();
 #endif
 
-  /* Schedule the work on the low priority worker thread */
+  aio_unlock();
+  if (ret >= 0)
+    {
+      return OK;
+    }
+
+errout:
+  aioc->aioc_aiocbp->aio_result = ret;
+  set_errno(-ret);
+  return ERROR;
+}
 
-  ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
+/****************************************************************************
+ * Name: aio_queue_list
+ *
+ * Description:
+ *   Append a batch of containers, linked through aioc_qlink in 'list', to
+ *   the submission queue under a single lock, with at most one worker
+ *   wakeup for the whole batch.
+ *
+ * Input Parameters:
+ *   list - The containers to submit, with aioc_io set.  The list is empty
+ *          on success and unchanged on failure.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int aio_queue_list(FAR dq_queue_t *list)
+{
+  FAR struct aio_container_s *aioc;
+  FAR dq_entry_t *entry;
+  int ret;
+
+  ret = aio_lock();
   if (ret < 0)
     {
-      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-      DEBUGASSERT(aiocbp);
+      return ret;
+    }
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
-      lpwork_restorepriority(aioc->aioc_prio);
+  sched_lock();
 #endif
-      aiocbp->aio_result = ret;
-      set_errno(-ret);
-      ret = ERROR;
+
+  /* The drain cannot take anything before the AIO lock is released, so it
+   * is safe to schedule it first and not have to undo the batch.
+   */
+
+  ret = aio_kick();
+  if (ret >= 0)
+    {
+      while ((entry = dq_remfirst(list)) != NULL)
+        {
+          aioc = container_of(entry, struct aio_container_s, aioc_qlink);
+          aio_enqueue(aioc);
+        }
     }
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Now the low-priority work queue might run at its new priority */
-
   sched_unlock();
 #endif
+
+  aio_unlock();
   return ret;
 }
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a container from the submission queue if no worker has started
+ *   its I/O yet.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container
+ *
+ * Returned Value:
+ *   true if the container was removed; false if its I/O has started.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+bool aio_dequeue(FAR struct aio_container_s *aioc)
+{
+  if (!aioc->aioc_queued)
+    {
+      return false;
+    }
+
+  dq_rem(&aioc->aioc_qlink, &g_aio_submit);
+  aioc->aioc_queued = false;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  lpwork_restorepriority(aioc->aioc_prio);
+#endif
+
+  return true;
+}
+
 #endif /* CONFIG_FS_AIO */
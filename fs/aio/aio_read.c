@@ -44,42 +44,24 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: aio_read_worker
+ * Name: aio_read_io
  *
  * Description:
- *   This function executes on the worker thread and performs the
- *   asynchronous I/O operation.
+ *   This function performs the asynchronous read operation, on the worker
+ *   thread or, for a non-blocking file, on the caller's thread.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc - The AIO container of the request
  *
  * Returned Value:
- *   None
+ *   The number of bytes read or a negated errno value.
  *
  ****************************************************************************/
 
-static void aio_read_worker(FAR void *arg)
+static ssize_t aio_read_io(FAR struct aio_container_s *aioc)
 {
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
-  ssize_t nread = 0;
-
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
+  FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+  ssize_t nread;
 
   /* Perform the file read using:
    *
@@ -91,33 +73,102 @@ static void aio_read_worker(FAR void *arg)
 
   nread = file_pread(aioc->aioc_filep, (FAR void *)aiocbp->aio_buf,
                      aiocbp->aio_nbytes, aiocbp->aio_offset);
+  if (nread == -ESPIPE)
+    {
+      /* The offset is ignored on files that cannot seek, e.g. sockets */
 
-  /* Set the result of the read operation. */
+      nread = file_read(aioc->aioc_filep, (FAR void *)aiocbp->aio_buf,
+                        aiocbp->aio_nbytes);
+    }
 
 #ifdef CONFIG_DEBUG_FS_ERROR
-  if (nread < 0)
+  if (nread < 0 && nread != -EAGAIN)
     {
       ferr("ERROR: read failed: %d\n", (int)nread);
     }
 #endif
 
-  aiocbp->aio_result = nread;
-
-  /* Signal the client */
-
-  aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
-
-  lpwork_restorepriority(prio);
-#endif
+  return nread;
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_read_prepare
+ *
+ * Description:
+ *   Check a read request and put it in a container ready for aio_queue()
+ *   or lio_submit().
+ *
+ * Input Parameters:
+ *   aiocbp - A pointer to an instance of struct aiocb
+ *   aiocp  - Location to return the container
+ *
+ * Returned Value:
+ *   One if the container was returned in 'aiocp'; zero if the request
+ *   already has its final aio_result (e.g. -EBADF); otherwise a negated
+ *   errno value if the request could not be submitted.
+ *
+ ****************************************************************************/
+
+int aio_read_prepare(FAR struct aiocb *aiocbp,
+                     FAR struct aio_container_s **aiocp)
+{
+  FAR struct aio_container_s *aioc;
+
+  if (aiocbp->aio_reqprio < 0)
+    {
+      return -EINVAL;
+    }
+
+  if (aiocbp->aio_fildes < 0)
+    {
+      /* the EBADF should be collected by aio_error(), we need return OK at
+       * here
+       */
+
+      aiocbp->aio_result = -EBADF;
+      return 0;
+    }
+
+  /* for aio_read, the aio_offset should be large or equal than 0 */
+
+  if (aiocbp->aio_offset < 0)
+    {
+      /* the EINVAL should be collected by aio_error(), we need to return OK
+       * here
+       */
+
+      aiocbp->aio_result = -EINVAL;
+      return 0;
+    }
+
+  /* The result -EINPROGRESS means that the transfer has not yet completed */
+
+  sigwork_init(&aiocbp->aio_sigwork);
+  aiocbp->aio_result = -EINPROGRESS;
+  aiocbp->aio_priv   = NULL;
+
+  /* Create a container for the AIO control block.  This may cause us to
+   * block if there are insufficient resources to satisfy the request.
+   */
+
+  aioc = aio_contain(aiocbp);
+  if (!aioc)
+    {
+      /* The errno has already been set (probably EBADF) */
+
+      aiocbp->aio_result = -get_errno();
+      return aiocbp->aio_result;
+    }
+
+  aioc->aioc_io = aio_read_io;
+  *aiocp = aioc;
+  return 1;
+}
+
 /****************************************************************************
  * Name: aio_read
  *
@@ -221,56 +272,21 @@ int aio_read(FAR struct aiocb *aiocbp)
 
   DEBUGASSERT(aiocbp);
 
-  if (aiocbp->aio_reqprio < 0)
+  ret = aio_read_prepare(aiocbp, &aioc);
+  if (ret <= 0)
     {
-      set_errno(EINVAL);
-      return ERROR;
-    }
-
-  if (aiocbp->aio_fildes < 0)
-    {
-      /* the EBADF should be collected by aio_error(), we need return OK at
-       * here
-       */
+      if (ret < 0)
+        {
+          set_errno(-ret);
+          return ERROR;
+        }
 
-      aiocbp->aio_result = -EBADF;
       return OK;
     }
 
-  /* for aio_read, the aio_offset should be large or equal than 0 */
-
-  if (aiocbp->aio_offset < 0)
-    {
-      /* the EINVAL should be collected by aio_error(), we need to return OK
-       * here
-       */
-
-      aiocbp->aio_result = -EINVAL;
-      return OK;
-    }
-
-  /* The result -EINPROGRESS means that the transfer has not yet completed */
-
-  sigwork_init(&aiocbp->aio_sigwork);
-  aiocbp->aio_result = -EINPROGRESS;
-  aiocbp->aio_priv   = NULL;
-
-  /* Create a container for the AIO control block.  This may cause us to
-   * block if there are insufficient resources to satisfy the request.
-   */
-
-  aioc = aio_contain(aiocbp);
-  if (!aioc)
-    {
-      /* The errno has already been set (probably EBADF) */
-
-      aiocbp->aio_result = -get_errno();
-      return ERROR;
-    }
-
-  /* Defer the work to the worker thread */
+  /* Complete the read now or defer it to the worker thread */
 
-  ret = aio_queue(aioc, aio_read_worker);
+  ret = aio_queue(aioc, aio_read_io, true);
   if (ret < 0)
     {
       /* The result and the errno have already been set */
@@ -46,52 +46,33 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: aio_write_worker
+ * Name: aio_write_io
  *
  * Description:
- *   This function executes on the worker thread and performs the
- *   asynchronous I/O operation.
+ *   This function performs the asynchronous write operation, on the worker
+ *   thread or, for a non-blocking file, on the caller's thread.
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc - The AIO container of the request
  *
  * Returned Value:
- *   None
+ *   The number of bytes written or a negated errno value.
  *
  ****************************************************************************/
 
-static void aio_write_worker(FAR void *arg)
+static ssize_t aio_write_io(FAR struct aio_container_s *aioc)
 {
-  FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
-  FAR struct aiocb *aiocbp;
-  pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t prio;
-#endif
-  ssize_t nwritten = 0;
+  FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+  ssize_t nwritten;
   int oflags;
 
-  /* Get the information from the container, decant the AIO control block,
-   * and free the container before starting any I/O.  That will minimize
-   * the delays by any other threads waiting for a pre-allocated container.
-   */
-
-  DEBUGASSERT(aioc && aioc->aioc_aiocbp);
-  pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  prio   = aioc->aioc_prio;
-#endif
-  aiocbp = aioc_decant(aioc);
-
   /* Call fcntl(F_GETFL) to get the file open mode. */
 
   oflags = file_fcntl(aioc->aioc_filep, F_GETFL);
   if (oflags < 0)
     {
       ferr("ERROR: file_fcntl failed: %d\n", oflags);
-      aiocbp->aio_result = oflags;
-      goto errout;
+      return oflags;
     }
 
   /* Perform the write using:
@@ -104,47 +85,118 @@ static void aio_write_worker(FAR void *arg)
 
   /* Check if O_APPEND is set in the file open flags */
 
-  if ((oflags & O_APPEND) != 0)
+  nwritten = -ESPIPE;
+  if ((oflags & O_APPEND) == 0)
     {
-      /* Append to the current file position */
+      nwritten = file_pwrite(aioc->aioc_filep,
+                             (FAR const void *)aiocbp->aio_buf,
+                             aiocbp->aio_nbytes,
+                             aiocbp->aio_offset);
+    }
+
+  if (nwritten == -ESPIPE)
+    {
+      /* Append to the current file position, or write a file that cannot
+       * seek such as a socket.
+       */
 
       nwritten = file_write(aioc->aioc_filep,
                             (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes);
     }
-  else
+
+  if (nwritten < 0 && nwritten != -EAGAIN)
     {
-      nwritten = file_pwrite(aioc->aioc_filep,
-                             (FAR const void *)aiocbp->aio_buf,
-                             aiocbp->aio_nbytes,
-                             aiocbp->aio_offset);
+      ferr("ERROR: write/pwrite/send failed: %zd\n", nwritten);
     }
 
-  if (nwritten < 0)
+  return nwritten;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_write_prepare
+ *
+ * Description:
+ *   Check a write request and put it in a container ready for aio_queue()
+ *   or lio_submit().
+ *
+ * Input Parameters:
+ *   aiocbp - A pointer to an instance of struct aiocb
+ *   aiocp  - Location to return the container
+ *
+ * Returned Value:
+ *   One if the container was returned in 'aiocp'; zero if the request
+ *   already has its final aio_result (e.g. -EBADF); otherwise a negated
+ *   errno value if the request could not be submitted.
+ *
+ ****************************************************************************/
+
+int aio_write_prepare(FAR struct aiocb *aiocbp,
+                      FAR struct aio_container_s **aiocp)
+{
+  FAR struct aio_container_s *aioc;
+  int flags;
+
+  if (aiocbp->aio_reqprio < 0)
     {
-      ferr("ERROR: write/pwrite/send failed: %zd\n", nwritten);
+      return -EINVAL;
     }
 
-  /* Save the result of the write */
+  if (aiocbp->aio_offset < 0)
+    {
+      aiocbp->aio_result = -EINVAL;
+      return 0;
+    }
 
-  aiocbp->aio_result = nwritten;
+  if (aiocbp->aio_fildes < 0)
+    {
+      /* for EBADF, the aio_write do not return error directly, but using
+       * aio_error to return this error code
+       */
 
-errout:
+      aiocbp->aio_result = -EBADF;
+      return 0;
+    }
 
-  /* Signal the client */
+  /* the aio_fildes that transferred in may be opened with O_RDONLY, for this
+   * case, we need to return OK directly, and using the aio_error to collect
+   * the EBADF error code
+   */
 
-  aio_signal(pid, aiocbp);
+  flags = fcntl(aiocbp->aio_fildes, F_GETFL);
+  if ((flags & O_WRONLY) == 0)
+    {
+      aiocbp->aio_result = -EBADF;
+      return 0;
+    }
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-  /* Restore the low priority worker thread default priority */
+  /* The result -EINPROGRESS means that the transfer has not yet completed */
 
-  lpwork_restorepriority(prio);
-#endif
-}
+  sigwork_init(&aiocbp->aio_sigwork);
+  aiocbp->aio_result = -EINPROGRESS;
+  aiocbp->aio_priv   = NULL;
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
+  /* Create a container for the AIO control block.  This may cause us to
+   * block if there are insufficient resources to satisfy the request.
+   */
+
+  aioc = aio_contain(aiocbp);
+  if (!aioc)
+    {
+      /* The errno has already been set (probably EBADF) */
+
+      aiocbp->aio_result = -get_errno();
+      return aiocbp->aio_result;
+    }
+
+  aioc->aioc_io = aio_write_io;
+  *aiocp = aioc;
+  return 1;
+}
 
 /****************************************************************************
  * Name: aio_write
@@ -248,66 +300,24 @@ int aio_write(FAR struct aiocb *aiocbp)
 {
   FAR struct aio_container_s *aioc;
   int ret;
-  int flags;
 
   DEBUGASSERT(aiocbp);
 
-  if (aiocbp->aio_reqprio < 0)
-    {
-      set_errno(EINVAL);
-      return ERROR;
-    }
-
-  if (aiocbp->aio_offset < 0)
-    {
-      aiocbp->aio_result = -EINVAL;
-      return OK;
-    }
-
-  if (aiocbp->aio_fildes < 0)
+  ret = aio_write_prepare(aiocbp, &aioc);
+  if (ret <= 0)
     {
-      /* for EBADF, the aio_write do not return error directly, but using
-       * aio_error to return this error code
-       */
+      if (ret < 0)
+        {
+          set_errno(-ret);
+          return ERROR;
+        }
 
-      aiocbp->aio_result = -EBADF;
-      return OK;
-    }
-
-  /* the aio_fildes that transferred in may be opened with O_RDONLY, for this
-   * case, we need to return OK directly, and using the aio_error to collect
-   * the EBADF error code
-   */
-
-  flags = fcntl(aiocbp->aio_fildes, F_GETFL);
-  if ((flags & O_WRONLY) == 0)
-    {
-      aiocbp->aio_result = -EBADF;
       return OK;
     }
 
-  /* The result -EINPROGRESS means that the transfer has not yet completed */
-
-  sigwork_init(&aiocbp->aio_sigwork);
-  aiocbp->aio_result = -EINPROGRESS;
-  aiocbp->aio_priv   = NULL;
-
-  /* Create a container for the AIO control block.  This may cause us to
-   * block if there are insufficient resources to satisfy the request.
-   */
-
-  aioc = aio_contain(aiocbp);
-  if (!aioc)
-    {
-      /* The errno has already been set (probably EBADF) */
-
-      aiocbp->aio_result = -get_errno();
-      return ERROR;
-    }
-
-  /* Defer the work to the worker thread */
+  /* Complete the write now or defer it to the worker thread */
 
-  ret = aio_queue(aioc, aio_write_worker);
+  ret = aio_queue(aioc, aio_write_io, true);
   if (ret < 0)
     {
       /* The result and the errno have already been set */
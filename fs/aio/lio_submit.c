@@ -0,0 +1,182 @@
+/****************************************************************************
+ * fs/aio/lio_submit.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lio_flush
+ *
+ * Description:
+ *   Submit the collected containers.  If that fails, record the error in
+ *   each request and release its container.
+ *
+ * Returned Value:
+ *   The number of requests that could not be submitted.
+ *
+ ****************************************************************************/
+
+static int lio_flush(FAR dq_queue_t *batch)
+{
+  FAR struct aio_container_s *aioc;
+  FAR dq_entry_t *entry;
+  int nfailed = 0;
+  int ret;
+
+  if (dq_empty(batch))
+    {
+      return 0;
+    }
+
+  ret = aio_queue_list(batch);
+  if (ret < 0)
+    {
+      ferr("ERROR: aio_queue_list failed: %d\n", ret);
+
+      while ((entry = dq_remfirst(batch)) != NULL)
+        {
+          aioc = container_of(entry, struct aio_container_s, aioc_qlink);
+          aioc->aioc_aiocbp->aio_result = ret;
+          aioc_decant(aioc);
+          nfailed++;
+        }
+    }
+
+  return nfailed;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lio_submit
+ *
+ * Description:
+ *   Submit all LIO_READ and LIO_WRITE requests in 'list' as if by
+ *   aio_read() and aio_write(), but as one batch: the requests are added
+ *   to the submission queue under a single lock and wake up the worker
+ *   thread at most once.  Requests on non-blocking files are first tried
+ *   on the caller's thread, as aio_read() and aio_write() do.  LIO_NOP
+ *   entries complete with a result of zero, and unknown opcodes complete
+ *   with EINVAL.  NULL entries are skipped.
+ *
+ *   This is the submission half of lio_listio(); waiting and notification
+ *   are left to the caller.  It is not a standard interface.
+ *
+ * Input Parameters:
+ *   list - The list of I/O operations to be performed
+ *   nent - The number of elements in the list
+ *
+ * Returned Value:
+ *   The number of LIO_READ and LIO_WRITE requests that were accepted, with
+ *   the same meaning as a zero return from aio_read() or aio_write().  A
+ *   request that was not accepted has its aio_result set to the negated
+ *   errno value.
+ *
+ ****************************************************************************/
+
+int lio_submit(FAR struct aiocb * const list[], int nent)
+{
+  FAR struct aio_container_s *aioc;
+  FAR struct aiocb *aiocbp;
+  dq_queue_t batch;
+  int naccepted = 0;
+  int ret;
+  int i;
+
+  DEBUGASSERT(list != NULL || nent == 0);
+
+  dq_init(&batch);
+  for (i = 0; i < nent; i++)
+    {
+      aiocbp = list[i];
+      if (aiocbp == NULL)
+        {
+          continue;
+        }
+
+      if (aiocbp->aio_lio_opcode == LIO_NOP)
+        {
+          aiocbp->aio_result = OK;
+          continue;
+        }
+
+      /* The containers held by the batch may be the ones that preparing
+       * this request would wait for.  Submit what we have first.
+       */
+
+      if (aioc_navail() == 0)
+        {
+          naccepted -= lio_flush(&batch);
+        }
+
+      if (aiocbp->aio_lio_opcode == LIO_READ)
+        {
+          ret = aio_read_prepare(aiocbp, &aioc);
+        }
+      else if (aiocbp->aio_lio_opcode == LIO_WRITE)
+        {
+          ret = aio_write_prepare(aiocbp, &aioc);
+        }
+      else
+        {
+          ferr("ERROR: Unrecognized opcode: %d\n", aiocbp->aio_lio_opcode);
+          ret = -EINVAL;
+        }
+
+      if (ret < 0)
+        {
+          aiocbp->aio_result = ret;
+          continue;
+        }
+
+      naccepted++;
+      if (ret > 0 && !aio_tryio(aioc))
+        {
+          dq_addlast(&aioc->aioc_qlink, &batch);
+        }
+    }
+
+  return naccepted - lio_flush(&batch);
+}
+
+#endif /* CONFIG_FS_AIO */
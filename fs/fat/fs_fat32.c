@@ -30,6 +30,7 @@
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/mount.h>
+#include <sys/param.h>
 
 #include <stdlib.h>
 #include <unistd.h>
@@ -384,6 +385,9 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
       off_t offset = fat_seek(filep, ff->ff_size, SEEK_SET);
       if (offset < 0)
         {
+#ifdef CONFIG_FAT_CLUSTERMAP
+          fs_heap_free(ff->ff_clustermap);
+#endif
           fs_heap_free(ff);
           return (int)offset;
         }
@@ -472,6 +476,13 @@ static int fat_close(FAR struct file *filep)
       fat_io_free(ff->ff_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_CLUSTERMAP
+  if (ff->ff_clustermap)
+    {
+      fs_heap_free(ff->ff_clustermap);
+    }
+#endif
+
   /* Then free the file structure itself. */
 
   fs_heap_free(ff);
@@ -553,6 +564,48 @@ out:
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_mapcluster
+ *
+ * Description:
+ *   Record that 'cluster' is the cluster at position 'index' in the chain
+ *   of the file.  Only extensions of the already mapped prefix are kept.
+ *   The map is only a cache, so allocation failures are ignored.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_CLUSTERMAP
+static void fat_mapcluster(FAR struct fat_file_s *ff, uint32_t index,
+                           uint32_t cluster)
+{
+  FAR uint32_t *map;
+  uint32_t size;
+
+  if (index != ff->ff_nmapped)
+    {
+      return;
+    }
+
+  if (index >= ff->ff_mapsize)
+    {
+      size = ff->ff_mapsize > 0 ? 2 * ff->ff_mapsize : 8;
+      map  = fs_heap_realloc(ff->ff_clustermap, size * sizeof(uint32_t));
+      if (map == NULL)
+        {
+          return;
+        }
+
+      ff->ff_clustermap = map;
+      ff->ff_mapsize    = size;
+    }
+
+  ff->ff_clustermap[index] = cluster;
+  ff->ff_nmapped++;
+}
+#else
+#  define fat_mapcluster(ff, index, cluster)
+#endif
+
 /****************************************************************************
  * Name: fat_get_sectors
  *
@@ -620,6 +673,30 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
       num_traversed = 1;
     }
 
+#ifdef CONFIG_FAT_CLUSTERMAP
+  /* Skip the part of the chain that has already been mapped.  The map is
+   * discarded if the chain no longer starts where it did.
+   */
+
+  if (ff->ff_startcluster != 0)
+    {
+      if (ff->ff_nmapped > 0 &&
+          ff->ff_clustermap[0] != ff->ff_startcluster)
+        {
+          ff->ff_nmapped = 0;
+        }
+
+      fat_mapcluster(ff, 0, ff->ff_startcluster);
+
+      i = MIN(num_clu, new_num_clu);
+      if (num_traversed < i && (int)ff->ff_nmapped > num_traversed)
+        {
+          num_traversed = MIN((int)ff->ff_nmapped, i);
+          cluster = ff->ff_clustermap[num_traversed - 1];
+        }
+    }
+#endif
+
   /* Traverse the existing chain */
 
   for (i = num_traversed; i < num_clu && i < new_num_clu; i++)
@@ -632,6 +709,8 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
         {
           return -EIO;
         }
+
+      fat_mapcluster(ff, i, cluster);
     }
 
   if (read)
@@ -696,6 +775,8 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
         {
           ff->ff_startcluster = cluster;
         }
+
+      fat_mapcluster(ff, i, cluster);
     }
 
   if (i == new_num_clu - 1)
@@ -723,6 +804,8 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
         {
           ff->ff_startcluster = cluster;
         }
+
+      fat_mapcluster(ff, i, cluster);
     }
 
   if (filep->f_pos > ff->ff_size)
@@ -1599,6 +1682,11 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_CLUSTERMAP
+  newff->ff_nmapped          = 0;                          /* Cluster map is not shared */
+  newff->ff_mapsize          = 0;
+  newff->ff_clustermap       = NULL;
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1918,6 +2006,14 @@ static int fat_truncate(FAR struct file *filep, off_t length)
        * length.
        */
 
+#ifdef CONFIG_FAT_CLUSTERMAP
+      /* Forget the clusters that are about to be released */
+
+      ff->ff_nmapped = MIN(ff->ff_nmapped,
+                           DIV_ROUND_UP(length, fs->fs_fatsecperclus *
+                                                fs->fs_hwsectorsize));
+#endif
+
       if (length == 0)
         {
           /* Shrink to length == 0 */
@@ -2358,6 +2454,10 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#if CONFIG_FAT_SECTORCACHE > 0
+  fat_fscachefree(fs);
+#endif
+
   nxmutex_destroy(&fs->fs_lock);
   fs_heap_free(fs);
   return OK;
@@ -2607,6 +2707,12 @@ static int fat_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
   fs->fs_currentsector = dirsector;
   memset(direntry, 0, fs->fs_hwsectorsize);
 
+#if CONFIG_FAT_SECTORCACHE > 0
+  /* The cluster is about to be overwritten behind the sector cache */
+
+  fat_fscachediscard(fs, dirsector, fs->fs_fatsecperclus);
+#endif
+
   /* Now clear all sectors in the new directory cluster (except for the
    * first).
    */
@@ -862,6 +862,18 @@
  * is mounted with a fat32 filesystem.
  */
 
+#if CONFIG_FAT_SECTORCACHE > 0
+/* One sector parked in the mountpoint sector cache */
+
+struct fat_cacheline_s
+{
+  off_t    cl_sector;              /* Sector held in cl_buffer (-1: none) */
+  uint32_t cl_lru;                 /* Age stamp of last use */
+  bool     cl_dirty;               /* true: cl_buffer must be written back */
+  uint8_t *cl_buffer;              /* Sector data */
+};
+#endif
+
 struct fat_file_s;
 struct fat_mountpt_s
 {
@@ -891,6 +903,11 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#if CONFIG_FAT_SECTORCACHE > 0
+  uint8_t *fs_cachepool;           /* Storage for all cache lines */
+  uint32_t fs_cachelru;            /* Age stamp of the last line used */
+  struct fat_cacheline_s fs_cache[CONFIG_FAT_SECTORCACHE];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -913,6 +930,11 @@ struct fat_file_s
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   off_t    ff_pos;                 /* Current position in the file */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_CLUSTERMAP
+  uint32_t ff_nmapped;             /* Number of valid entries in ff_clustermap */
+  uint32_t ff_mapsize;             /* Allocated entries in ff_clustermap */
+  uint32_t *ff_clustermap;         /* Cluster chain of the file, in order */
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1093,6 +1115,12 @@ EXTERN int    fat_remove(FAR struct fat_mountpt_s *fs,
 
 EXTERN int    fat_fscacheflush(FAR struct fat_mountpt_s *fs);
 EXTERN int    fat_fscacheread(FAR struct fat_mountpt_s *fs, off_t sector);
+#if CONFIG_FAT_SECTORCACHE > 0
+EXTERN int    fat_fscachealloc(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_fscachefree(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_fscachediscard(FAR struct fat_mountpt_s *fs, off_t sector,
+                                 off_t nsectors);
+#endif
 EXTERN int    fat_ffcacheflush(FAR struct fat_mountpt_s *fs,
                                FAR struct fat_file_s *ff);
 EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
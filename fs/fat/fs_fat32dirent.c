@@ -2805,6 +2805,10 @@ int fat_allocatedirentry(FAR struct fat_mountpt_s *fs,
       fs->fs_currentsector = fat_cluster2sector(fs, cluster);
       memset(fs->fs_buffer, 0, fs->fs_hwsectorsize);
 
+#if CONFIG_FAT_SECTORCACHE > 0
+      fat_fscachediscard(fs, fs->fs_currentsector, fs->fs_fatsecperclus);
+#endif
+
       sector = fs->fs_currentsector;
       for (i = fs->fs_fatsecperclus; i; i--)
         {
@@ -270,6 +270,191 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one sector from 'buffer' to the device.  If the sector lies in
+ *   the FAT region, the change is also made in each copy of the FAT.
+ *
+ ****************************************************************************/
+
+static int fat_writesector(struct fat_mountpt_s *fs, FAR uint8_t *buffer,
+                           off_t sector)
+{
+  int ret;
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      int i;
+
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+#if CONFIG_FAT_SECTORCACHE > 0
+/****************************************************************************
+ * Name: fat_fscachewriteback
+ *
+ * Description:
+ *   Write back every dirty sector parked in the sector cache.
+ *
+ ****************************************************************************/
+
+static int fat_fscachewriteback(struct fat_mountpt_s *fs)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      FAR struct fat_cacheline_s *line = &fs->fs_cache[i];
+
+      if (line->cl_dirty)
+        {
+          ret = fat_writesector(fs, line->cl_buffer, line->cl_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          line->cl_dirty = false;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscacheswap
+ *
+ * Description:
+ *   Replace the sector in fs_buffer with 'sector'.  The sector currently in
+ *   fs_buffer is copied into a cache line (the line that already holds that
+ *   sector, else the least recently used line, which is written back first
+ *   if dirty).  The requested sector is then taken out of its cache line,
+ *   along with its dirty state, or read from the device on a miss.
+ *
+ *   fs_buffer itself never moves because many callers hold pointers into
+ *   it.
+ *
+ ****************************************************************************/
+
+static int fat_fscacheswap(struct fat_mountpt_s *fs, off_t sector)
+{
+  FAR struct fat_cacheline_s *victim = NULL;
+  FAR struct fat_cacheline_s *line;
+  int ret;
+  int i;
+
+  if (fs->fs_currentsector >= 0)
+    {
+      for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+        {
+          line = &fs->fs_cache[i];
+          if (line->cl_sector == fs->fs_currentsector)
+            {
+              /* Only possible when fs_currentsector was set directly; the
+               * line is stale and fs_buffer holds the up-to-date content.
+               */
+
+              victim = line;
+              break;
+            }
+
+          if (line->cl_sector == sector)
+            {
+              continue;
+            }
+
+          if (victim == NULL || line->cl_sector < 0 ||
+              (victim->cl_sector >= 0 && line->cl_lru < victim->cl_lru))
+            {
+              victim = line;
+            }
+        }
+
+      if (victim == NULL)
+        {
+          /* The only line holds the requested sector.  Fall back to
+           * writing the current sector out directly.
+           */
+
+          ret = fat_fscacheflush(fs);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+      else
+        {
+          if (victim->cl_dirty && victim->cl_sector != fs->fs_currentsector)
+            {
+              ret = fat_writesector(fs, victim->cl_buffer,
+                                    victim->cl_sector);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
+
+          memcpy(victim->cl_buffer, fs->fs_buffer, fs->fs_hwsectorsize);
+          victim->cl_sector = fs->fs_currentsector;
+          victim->cl_dirty  = fs->fs_dirty;
+          victim->cl_lru    = ++fs->fs_cachelru;
+          fs->fs_dirty      = false;
+        }
+    }
+
+  /* fs_buffer is now free.  Look for the requested sector in the cache */
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      line = &fs->fs_cache[i];
+      if (line->cl_sector == sector)
+        {
+          memcpy(fs->fs_buffer, line->cl_buffer, fs->fs_hwsectorsize);
+          fs->fs_dirty    = line->cl_dirty;
+          line->cl_sector = -1;
+          line->cl_dirty  = false;
+          return OK;
+        }
+    }
+
+  /* Cache miss; read the sector from the device */
+
+  ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
+  if (ret < 0)
+    {
+      fs->fs_currentsector = -1;
+      return ret;
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -613,6 +798,16 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
         }
     }
 
+#if CONFIG_FAT_SECTORCACHE > 0
+  /* Allocate the sector cache */
+
+  ret = fat_fscachealloc(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+#endif
+
   /* We have what appears to be a valid FAT filesystem! Now read the
    * FSINFO sector (FAT32 only)
    */
@@ -658,6 +853,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#if CONFIG_FAT_SECTORCACHE > 0
+  fat_fscachefree(fs);
+#endif
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = NULL;
 
@@ -1144,6 +1342,13 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
           return ret;
         }
 
+#if CONFIG_FAT_SECTORCACHE > 0
+      /* Forget any cached sectors of the freed cluster */
+
+      fat_fscachediscard(fs, fat_cluster2sector(fs, cluster),
+                         fs->fs_fatsecperclus);
+#endif
+
       /* Update FSINFINFO data */
 
       if (fs->fs_fsifreecount != 0xffffffff)
@@ -1776,39 +1981,29 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
   if (fs->fs_dirty)
     {
-      /* Write the dirty sector */
+      /* Write the dirty sector (and its FAT copies) */
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
     }
 
+#if CONFIG_FAT_SECTORCACHE > 0
+  /* Then write back any dirty sectors parked in the sector cache */
+
+  ret = fat_fscachewriteback(fs);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
   return OK;
 }
 
@@ -1832,6 +2027,18 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 
   if (fs->fs_currentsector != sector)
     {
+#if CONFIG_FAT_SECTORCACHE > 0
+      /* Park the current sector in the sector cache and then fetch the
+       * requested sector, from the cache if it is there.  Write-back of a
+       * dirty sector is deferred until its cache line is reused.
+       */
+
+      ret = fat_fscacheswap(fs, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#else
       /* We will need to read the new sector.  First, flush the cached
        * sector if it is dirty.
        */
@@ -1849,6 +2056,7 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
         {
           return ret;
         }
+#endif
 
       /* Update the cached sector number */
 
@@ -1858,6 +2066,91 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
   return OK;
 }
 
+#if CONFIG_FAT_SECTORCACHE > 0
+/****************************************************************************
+ * Name: fat_fscachealloc
+ *
+ * Description:
+ *   Allocate the sector cache lines of a mountpoint.  fs_buffer is marked
+ *   as holding no sector so that whatever the mount logic left in it is
+ *   never parked in the cache.
+ *
+ ****************************************************************************/
+
+int fat_fscachealloc(struct fat_mountpt_s *fs)
+{
+  int i;
+
+  fs->fs_cachepool = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_SECTORCACHE * fs->fs_hwsectorsize);
+  if (!fs->fs_cachepool)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      fs->fs_cache[i].cl_sector = -1;
+      fs->fs_cache[i].cl_lru    = 0;
+      fs->fs_cache[i].cl_dirty  = false;
+      fs->fs_cache[i].cl_buffer = fs->fs_cachepool +
+                                  i * fs->fs_hwsectorsize;
+    }
+
+  fs->fs_cachelru      = 0;
+  fs->fs_currentsector = -1;
+  fs->fs_dirty         = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscachefree
+ *
+ * Description:
+ *   Release the sector cache lines.  Any dirty lines are discarded; the
+ *   caller must flush them first if they are still wanted.
+ *
+ ****************************************************************************/
+
+void fat_fscachefree(struct fat_mountpt_s *fs)
+{
+  if (fs->fs_cachepool)
+    {
+      fat_io_free(fs->fs_cachepool,
+                  CONFIG_FAT_SECTORCACHE * fs->fs_hwsectorsize);
+      fs->fs_cachepool = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_fscachediscard
+ *
+ * Description:
+ *   Drop any cached copies of the 'nsectors' sectors starting at 'sector',
+ *   dirty or not.  This is used when the sectors are released (e.g., the
+ *   clusters of a deleted directory) so that stale contents are never
+ *   written back over a later owner's data.
+ *
+ ****************************************************************************/
+
+void fat_fscachediscard(struct fat_mountpt_s *fs, off_t sector,
+                        off_t nsectors)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_SECTORCACHE; i++)
+    {
+      FAR struct fat_cacheline_s *line = &fs->fs_cache[i];
+
+      if (line->cl_sector >= sector && line->cl_sector < sector + nsectors)
+        {
+          line->cl_sector = -1;
+          line->cl_dirty  = false;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_ffcacheflush
  *
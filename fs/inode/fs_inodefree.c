@@ -65,6 +65,10 @@ void inode_free(FAR struct inode *inode)
       inode_free(inode->i_peer);
       inode_free(inode->i_child);
 
+      /* Children of an unlinked node are still indexed under it */
+
+      inode_hash_remove(inode);
+
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
       /* If the inode is a symbolic link, the free the path to the linked
        * entity.
@@ -0,0 +1,318 @@
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+struct inode_pathcache_s
+{
+  FAR struct inode *node;     /* The inode that the path resolved to */
+  FAR struct inode *parent;   /* The parent of that inode */
+  uint32_t          gen;      /* Tree generation when entry was filled */
+  char              path[CONFIG_PSEUDOFS_PATHCACHE_NAMELEN];
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Children of all directories, keyed by (i_parent, i_name) */
+
+static FAR struct inode *g_inode_hash[CONFIG_PSEUDOFS_INODE_HASHSIZE];
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+/* Incremented whenever an inode is linked into or out of the tree.  A
+ * cache entry filled under an older generation may refer to a freed inode
+ * and is ignored.
+ */
+
+static uint32_t g_inode_gen = 1;
+
+/* Lookups run under the shared (read) inode lock, so updates of the cache
+ * itself must be serialized separately.
+ */
+
+static spinlock_t g_pathcache_lock = SP_UNLOCKED;
+static struct inode_pathcache_s
+g_pathcache[CONFIG_PSEUDOFS_PATHCACHE_ENTRIES];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hash_key
+ *
+ * Description:
+ *   Return the bucket for the child of 'parent' named by the first segment
+ *   of 'name' (terminated by '/' or NUL).
+ *
+ ****************************************************************************/
+
+static unsigned int inode_hash_key(FAR struct inode *parent,
+                                   FAR const char *name)
+{
+  uint32_t hash = (uint32_t)(uintptr_t)parent * 0x9e3779b1u;
+
+  while (*name != '\0' && *name != '/')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 0x01000193u;
+    }
+
+  return (hash ^ (hash >> 16)) % CONFIG_PSEUDOFS_INODE_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: inode_hash_match
+ *
+ * Description:
+ *   Return true if the inode name equals the first segment of 'name'.
+ *
+ ****************************************************************************/
+
+static bool inode_hash_match(FAR const char *nname, FAR const char *name)
+{
+  while (*nname != '\0' && *nname == *name)
+    {
+      nname++;
+      name++;
+    }
+
+  return *nname == '\0' && (*name == '\0' || *name == '/');
+}
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+/****************************************************************************
+ * Name: inode_pathcache_key
+ ****************************************************************************/
+
+static unsigned int inode_pathcache_key(FAR const char *path)
+{
+  uint32_t hash = 0x811c9dc5u;
+
+  while (*path != '\0')
+    {
+      hash = (hash ^ (uint8_t)*path++) * 0x01000193u;
+    }
+
+  return hash % CONFIG_PSEUDOFS_PATHCACHE_ENTRIES;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hash_insert
+ *
+ * Description:
+ *   Enter a newly linked inode in the index of its parent's children.
+ *
+ ****************************************************************************/
+
+void inode_hash_insert(FAR struct inode *inode)
+{
+  unsigned int key;
+
+  DEBUGASSERT(inode != NULL && inode->i_parent != NULL);
+
+  key               = inode_hash_key(inode->i_parent, inode->i_name);
+  inode->i_hnext    = g_inode_hash[key];
+  g_inode_hash[key] = inode;
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+  g_inode_gen++;
+#endif
+}
+
+/****************************************************************************
+ * Name: inode_hash_remove
+ *
+ * Description:
+ *   Remove an inode from the index.  This must be called before i_parent
+ *   is changed.  It is harmless to remove an inode that is not indexed.
+ *
+ ****************************************************************************/
+
+void inode_hash_remove(FAR struct inode *inode)
+{
+  FAR struct inode **pprev;
+
+  DEBUGASSERT(inode != NULL);
+
+  if (inode->i_parent == NULL)
+    {
+      return;
+    }
+
+  pprev = &g_inode_hash[inode_hash_key(inode->i_parent, inode->i_name)];
+  while (*pprev != NULL)
+    {
+      if (*pprev == inode)
+        {
+          *pprev         = inode->i_hnext;
+          inode->i_hnext = NULL;
+          break;
+        }
+
+      pprev = &(*pprev)->i_hnext;
+    }
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+  g_inode_gen++;
+#endif
+}
+
+/****************************************************************************
+ * Name: inode_hash_find
+ *
+ * Description:
+ *   Return the child of 'parent' named by the first segment of 'name'.
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_hash_find(FAR struct inode *parent,
+                                  FAR const char *name)
+{
+  FAR struct inode *inode;
+
+  inode = g_inode_hash[inode_hash_key(parent, name)];
+  while (inode != NULL)
+    {
+      if (inode->i_parent == parent &&
+          inode_hash_match(inode->i_name, name))
+        {
+          break;
+        }
+
+      inode = inode->i_hnext;
+    }
+
+  return inode;
+}
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+/****************************************************************************
+ * Name: inode_pathcache_lookup
+ *
+ * Description:
+ *   Resolve 'desc->path' from the path cache.  On a hit the search
+ *   descriptor is filled in exactly as a successful _inode_search() that
+ *   consumed the whole path would have done (with a NULL peer).
+ *
+ ****************************************************************************/
+
+bool inode_pathcache_lookup(FAR struct inode_search_s *desc)
+{
+  FAR struct inode_pathcache_s *entry;
+  FAR struct inode *node = NULL;
+  FAR struct inode *parent = NULL;
+  FAR struct inode *above;
+  irqstate_t flags;
+
+  entry = &g_pathcache[inode_pathcache_key(desc->path)];
+
+  flags = spin_lock_irqsave(&g_pathcache_lock);
+  if (entry->gen == g_inode_gen && strcmp(entry->path, desc->path) == 0)
+    {
+      node   = entry->node;
+      parent = entry->parent;
+    }
+
+  spin_unlock_irqrestore(&g_pathcache_lock, flags);
+
+  if (node == NULL)
+    {
+      return false;
+    }
+
+  /* Mounting on an existing inode does not change the shape of the tree.
+   * If any ancestor has since become a mountpoint, the full search must
+   * stop there instead.
+   */
+
+  for (above = parent; above != NULL; above = above->i_parent)
+    {
+      if (INODE_IS_MOUNTPT(above))
+        {
+          return false;
+        }
+    }
+
+  desc->path    = desc->path + strlen(desc->path);
+  desc->node    = node;
+  desc->peer    = NULL;
+  desc->parent  = parent;
+  desc->relpath = desc->path;
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_pathcache_add
+ *
+ * Description:
+ *   Remember that 'path' resolves to 'node'.  Paths that do not fit in a
+ *   cache entry are silently ignored.
+ *
+ ****************************************************************************/
+
+void inode_pathcache_add(FAR const char *path, FAR struct inode *node,
+                         FAR struct inode *parent)
+{
+  FAR struct inode_pathcache_s *entry;
+  irqstate_t flags;
+
+  if (strlen(path) >= CONFIG_PSEUDOFS_PATHCACHE_NAMELEN)
+    {
+      return;
+    }
+
+  entry = &g_pathcache[inode_pathcache_key(path)];
+
+  flags = spin_lock_irqsave(&g_pathcache_lock);
+  strlcpy(entry->path, path, sizeof(entry->path));
+  entry->node   = node;
+  entry->parent = parent;
+  entry->gen    = g_inode_gen;
+  spin_unlock_irqrestore(&g_pathcache_lock, flags);
+}
+#endif /* CONFIG_PSEUDOFS_PATHCACHE */
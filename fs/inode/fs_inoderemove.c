@@ -79,6 +79,24 @@ static FAR struct inode *inode_unlink(FAR const char *path)
       inode = desc.node;
       DEBUGASSERT(inode != NULL);
 
+#ifdef CONFIG_PSEUDOFS_INODE_HASH
+      /* A hashed lookup does not return the peer to the "left" of the
+       * node, so find it now.
+       */
+
+      DEBUGASSERT(desc.parent != NULL);
+      if (desc.parent->i_child != inode)
+        {
+          desc.peer = desc.parent->i_child;
+          while (desc.peer->i_peer != inode)
+            {
+              desc.peer = desc.peer->i_peer;
+            }
+        }
+
+      inode_hash_remove(inode);
+#endif
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
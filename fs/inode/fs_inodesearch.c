@@ -221,6 +221,9 @@ static int _inode_search(FAR struct inode_search_s *desc)
   FAR struct inode *left    = NULL;
   FAR struct inode *above   = NULL;
   FAR const char   *relpath = NULL;
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+  bool              linked  = false;
+#endif
   int ret = -ENOENT;
 
   /* Get the search path, skipping over the leading '/'.  The leading '/' is
@@ -235,6 +238,15 @@ static int _inode_search(FAR struct inode_search_s *desc)
       return -EINVAL;
     }
 
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+  /* Hot paths usually resolve straight from the cache */
+
+  if (inode_pathcache_lookup(desc))
+    {
+      return OK;
+    }
+#endif
+
   /* Traverse the pseudo file system node tree until either (1) all nodes
    * have been examined without finding the matching node, or (2) the
    * matching node is found.
@@ -306,6 +318,12 @@ static int _inode_search(FAR struct inode_search_s *desc)
                 {
                   int status;
 
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+                  /* The result depends on the link target; don't cache */
+
+                  linked = true;
+#endif
+
                   /* If this intermediate inode in the is a soft link, then
                    * (1) recursively look-up the inode referenced by the
                    * soft link, and (2) continue searching with that inode
@@ -386,7 +404,20 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
               above = inode;
               left  = NULL;
+#ifdef CONFIG_PSEUDOFS_INODE_HASH
+              /* Go straight to the matching child if it is indexed.
+               * Otherwise walk the ordered list of peers so that the
+               * insertion point ("left") is returned on failure.
+               */
+
+              inode = inode_hash_find(above, name);
+              if (inode == NULL)
+                {
+                  inode = above->i_child;
+                }
+#else
               inode = inode->i_child;
+#endif
             }
         }
     }
@@ -407,6 +438,13 @@ static int _inode_search(FAR struct inode_search_s *desc)
    *   (4) When the node matching the full path is found
    */
 
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+  if (ret >= 0 && !linked && *relpath == '\0')
+    {
+      inode_pathcache_add(desc->path, inode, above);
+    }
+#endif
+
   desc->path    = name;
   desc->node    = inode;
   desc->peer    = left;
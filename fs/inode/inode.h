@@ -100,7 +100,9 @@
  *  node     - INPUT:  (not used)
  *             OUTPUT: On success, holds the pointer to the inode found.
  *  peer     - INPUT:  (not used)
- *             OUTPUT: The inode to the "left" of the inode found.
+ *             OUTPUT: The inode to the "left" of the inode found.  With
+ *                     CONFIG_PSEUDOFS_INODE_HASH this is only valid when
+ *                     the search fails; a hashed hit leaves it NULL.
  *  parent   - INPUT:  (not used)
  *             OUTPUT: The inode to the "above" of the inode found.
  *  relpath  - INPUT:  (not used)
@@ -336,6 +338,50 @@ void inode_free(FAR struct inode *inode);
 
 const char *inode_nextname(FAR const char *name);
 
+/****************************************************************************
+ * Name: inode_hash_insert, inode_hash_remove, and inode_hash_find
+ *
+ * Description:
+ *   Maintain and query the optional index of inode children.  Every inode
+ *   linked into the tree below the root is entered in the index under the
+ *   pair (i_parent, i_name).  inode_hash_find() returns the child of
+ *   'parent' named by the first segment of 'name' or NULL if there is
+ *   none.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore (exclusively for insert/remove).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PSEUDOFS_INODE_HASH
+void inode_hash_insert(FAR struct inode *inode);
+void inode_hash_remove(FAR struct inode *inode);
+FAR struct inode *inode_hash_find(FAR struct inode *parent,
+                                  FAR const char *name);
+#else
+#  define inode_hash_insert(i)
+#  define inode_hash_remove(i)
+#endif
+
+/****************************************************************************
+ * Name: inode_pathcache_lookup and inode_pathcache_add
+ *
+ * Description:
+ *   Look up or remember the result of resolving an absolute path that ends
+ *   on an inode of the pseudo-filesystem.  inode_pathcache_lookup() fills
+ *   in 'desc' as _inode_search() would and returns true on a hit.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PSEUDOFS_PATHCACHE
+bool inode_pathcache_lookup(FAR struct inode_search_s *desc);
+void inode_pathcache_add(FAR const char *path, FAR struct inode *node,
+                         FAR struct inode *parent);
+#endif
+
 /****************************************************************************
  * Name: inode_root_reserve
  *
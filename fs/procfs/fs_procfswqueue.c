@@ -0,0 +1,342 @@
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "fs_heap.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_WORKQUEUE_STATS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define WQUEUE_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;    /* Base open file structure */
+  unsigned int linesize;        /* Number of valid characters in line[] */
+  char line[WQUEUE_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_wqueue_operations =
+{
+  wqueue_open,    /* open */
+  wqueue_close,   /* close */
+  wqueue_read,    /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  wqueue_dup,     /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  wqueue_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                      int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct wqueue_file_s *)
+    fs_heap_zalloc(sizeof(struct wqueue_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  fs_heap_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_perf2usec
+ *
+ * Description:
+ *   Convert a count of perf timer ticks to microseconds.  The statistics
+ *   are kept in 64 bits, so they cannot go through perf_convert(), which
+ *   takes a clock_t that may only be 32 bits wide.
+ *
+ ****************************************************************************/
+
+static uint64_t wqueue_perf2usec(uint64_t count)
+{
+  uint64_t freq = perf_getfreq();
+
+  return count / freq * USEC_PER_SEC + count % freq * USEC_PER_SEC / freq;
+}
+
+/****************************************************************************
+ * Name: wqueue_line
+ *
+ * Description:
+ *   Format the statistics of one work queue.
+ *
+ ****************************************************************************/
+
+static size_t wqueue_line(FAR struct wqueue_file_s *wqfile,
+                          FAR const char *name, int qid)
+{
+  struct work_stats_s stats;
+  uint64_t avg;
+
+  if (work_queue_stats(qid, &stats) < 0)
+    {
+      return 0;
+    }
+
+  avg = stats.nworks > 0 ? stats.latency / stats.nworks : 0;
+
+  return procfs_snprintf(wqfile->line, WQUEUE_LINELEN,
+                         "%-8s%10" PRIu32 "%10" PRIu32 "%10lu%10lu\n",
+                         name, stats.nworks, stats.nsteals,
+                         (unsigned long)wqueue_perf2usec(avg),
+                         (unsigned long)wqueue_perf2usec(stats.maxlatency));
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *wqfile;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  wqfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(wqfile);
+
+  /* The first line is the headers.  Latencies are in microseconds. */
+
+  linesize  = procfs_snprintf(wqfile->line, WQUEUE_LINELEN,
+                              "%-8s%10s%10s%10s%10s\n",
+                              "queue", "nworks", "nsteals", "avglat",
+                              "maxlat");
+
+  copysize  = procfs_memcpy(wqfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+#ifdef CONFIG_SCHED_HPWORK
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  linesize   = wqueue_line(wqfile, "hpwork", HPWORK);
+  copysize   = procfs_memcpy(wqfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  buffer   += copysize;
+  buflen   -= copysize;
+
+  linesize   = wqueue_line(wqfile, "lpwork", LPWORK);
+  copysize   = procfs_memcpy(wqfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+#endif
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct wqueue_file_s *)
+    fs_heap_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_WORKQUEUE_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
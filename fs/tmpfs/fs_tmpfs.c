@@ -58,6 +58,11 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+#  define TMPFS_PAGESIZE     CONFIG_FS_TMPFS_PAGESIZE
+#  define TMPFS_NPAGES(size) (((size) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+#endif
+
 #define tmpfs_lock(fs) \
            nxrmutex_lock(&fs->tfs_lock)
 #define tmpfs_lock_object(to) \
@@ -94,6 +99,11 @@ struct tmpfs_dir_s
 
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo);
+#ifdef CONFIG_FS_TMPFS_PAGED
+static FAR uint8_t *tmpfs_file_page(FAR struct tmpfs_file_s *tfo,
+                                    size_t index);
+#endif
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
@@ -268,6 +278,141 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+/****************************************************************************
+ * Name: tmpfs_free_filedata
+ ****************************************************************************/
+
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo)
+{
+#ifdef CONFIG_FS_TMPFS_PAGED
+  size_t i;
+
+  for (i = 0; i < tfo->tfo_npages; i++)
+    {
+      fs_heap_free(tfo->tfo_pages[i]);
+    }
+
+  fs_heap_free(tfo->tfo_pages);
+  tfo->tfo_pages  = NULL;
+  tfo->tfo_npages = 0;
+#else
+  fs_heap_free(tfo->tfo_data);
+  tfo->tfo_data   = NULL;
+#endif
+  tfo->tfo_alloc  = 0;
+}
+
+#ifdef CONFIG_FS_TMPFS_PAGED
+/****************************************************************************
+ * Name: tmpfs_file_page
+ *
+ * Description:
+ *   Return the page holding file data at 'index' * TMPFS_PAGESIZE,
+ *   allocating a zeroed page if that part of the file is a hole.  Returns
+ *   NULL if memory is exhausted.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_file_page(FAR struct tmpfs_file_s *tfo,
+                                    size_t index)
+{
+  if (index >= tfo->tfo_npages)
+    {
+      FAR uint8_t **newpages;
+      size_t npages;
+
+      /* Grow the page list geometrically so that streaming appends
+       * reallocate it only rarely.
+       */
+
+      npages = tfo->tfo_npages * 2;
+      if (npages <= index)
+        {
+          npages = index + 1;
+        }
+
+      newpages = fs_heap_realloc(tfo->tfo_pages,
+                                 npages * sizeof(FAR uint8_t *));
+      if (newpages == NULL)
+        {
+          return NULL;
+        }
+
+      memset(&newpages[tfo->tfo_npages], 0,
+             (npages - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+      tfo->tfo_pages  = newpages;
+      tfo->tfo_npages = npages;
+    }
+
+  if (tfo->tfo_pages[index] == NULL)
+    {
+      tfo->tfo_pages[index] = fs_heap_zalloc(TMPFS_PAGESIZE);
+      if (tfo->tfo_pages[index] != NULL)
+        {
+          tfo->tfo_alloc += TMPFS_PAGESIZE;
+        }
+    }
+
+  return tfo->tfo_pages[index];
+}
+
+/****************************************************************************
+ * Name: tmpfs_realloc_file
+ ****************************************************************************/
+
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  size_t npages;
+  size_t offset;
+  size_t i;
+
+  /* Growing the file only moves the end of file.  The new range is a hole
+   * and pages are allocated when it is written.
+   */
+
+  if (newsize >= tfo->tfo_size)
+    {
+      tfo->tfo_size = newsize;
+      return OK;
+    }
+
+  if (newsize == 0)
+    {
+      tmpfs_free_filedata(tfo);
+      tfo->tfo_size = 0;
+      return OK;
+    }
+
+  /* Shrinking ... Free all pages beyond the new end of file */
+
+  npages = TMPFS_NPAGES(newsize);
+  for (i = npages; i < tfo->tfo_npages; i++)
+    {
+      if (tfo->tfo_pages[i] != NULL)
+        {
+          fs_heap_free(tfo->tfo_pages[i]);
+          tfo->tfo_pages[i] = NULL;
+          tfo->tfo_alloc -= TMPFS_PAGESIZE;
+        }
+    }
+
+  /* The tail of the last page must read back as zero if the file grows
+   * again.
+   */
+
+  offset = newsize % TMPFS_PAGESIZE;
+  if (offset != 0 && npages <= tfo->tfo_npages &&
+      tfo->tfo_pages[npages - 1] != NULL)
+    {
+      memset(tfo->tfo_pages[npages - 1] + offset, 0,
+             TMPFS_PAGESIZE - offset);
+    }
+
+  tfo->tfo_size = newsize;
+  return OK;
+}
+#else
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
@@ -291,9 +436,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
         {
           /* Free the file object */
 
-          fs_heap_free(tfo->tfo_data);
-          tfo->tfo_data = NULL;
-          tfo->tfo_alloc = 0;
+          tmpfs_free_filedata(tfo);
           tfo->tfo_size = 0;
           return OK;
         }
@@ -345,6 +488,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   tfo->tfo_data  = newdata;
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -383,7 +527,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       fs_heap_free(tfo);
     }
 
@@ -582,7 +726,12 @@ tmpfs_alloc_file(FAR struct tmpfs_directory_s *parent)
   tfo->tfo_parent = parent;
   tfo->tfo_flags  = 0;
   tfo->tfo_size   = 0;
+#ifdef CONFIG_FS_TMPFS_PAGED
+  tfo->tfo_npages = 0;
+  tfo->tfo_pages  = NULL;
+#else
   tfo->tfo_data   = NULL;
+#endif
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1189,7 +1338,15 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+#ifdef CONFIG_FS_TMPFS_PAGED
+      /* Holes are part of the size but not of the allocation */
+
+      if (to->to_alloc > tmptfo->tfo_size)
+#endif
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1265,7 +1422,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1586,6 +1743,35 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  while (startpos < endpos)
+    {
+      size_t index  = startpos / TMPFS_PAGESIZE;
+      size_t offset = startpos % TMPFS_PAGESIZE;
+      size_t chunk  = TMPFS_PAGESIZE - offset;
+
+      if (chunk > (size_t)(endpos - startpos))
+        {
+          chunk = endpos - startpos;
+        }
+
+      /* A hole reads back as zeros */
+
+      if (index < tfo->tfo_npages && tfo->tfo_pages[index] != NULL)
+        {
+          memcpy(buffer, tfo->tfo_pages[index] + offset, chunk);
+        }
+      else
+        {
+          memset(buffer, 0, chunk);
+        }
+
+      buffer   += chunk;
+      startpos += chunk;
+    }
+
+  filep->f_pos += nread;
+#else
   if (tfo->tfo_data != NULL)
     {
       memcpy(buffer, &tfo->tfo_data[startpos], nread);
@@ -1595,6 +1781,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
     }
+#endif
 
   /* Release the lock on the file */
 
@@ -1645,6 +1832,45 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   nwritten = buflen;
   endpos   = startpos + buflen;
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  /* Copy the user buffer into the file pages, allocating only the pages
+   * that are touched.  Stop early if memory is exhausted.
+   */
+
+  for (nwritten = 0; startpos + nwritten < endpos; )
+    {
+      off_t  pos    = startpos + nwritten;
+      size_t offset = pos % TMPFS_PAGESIZE;
+      size_t chunk  = TMPFS_PAGESIZE - offset;
+      FAR uint8_t *page;
+
+      page = tmpfs_file_page(tfo, pos / TMPFS_PAGESIZE);
+      if (page == NULL)
+        {
+          break;
+        }
+
+      if (chunk > (size_t)(endpos - pos))
+        {
+          chunk = endpos - pos;
+        }
+
+      memcpy(page + offset, buffer + nwritten, chunk);
+      nwritten += chunk;
+    }
+
+  if (nwritten == 0 && buflen > 0)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  endpos = startpos + nwritten;
+  if (endpos > tfo->tfo_size)
+    {
+      tfo->tfo_size = endpos;
+    }
+#else
   if (endpos > tfo->tfo_size)
     {
       /* Reallocate the file to handle the write past the end of the file. */
@@ -1666,6 +1892,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nwritten == 0);
     }
+#endif
 
   filep->f_pos = endpos;
 
@@ -1788,7 +2015,31 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
   if (map->offset >= 0 && map->offset < tfo->tfo_size &&
       map->length && map->offset + map->length <= tfo->tfo_size)
     {
+#ifdef CONFIG_FS_TMPFS_PAGED
+      FAR uint8_t *page;
+      size_t offset = map->offset % TMPFS_PAGESIZE;
+
+      /* Only a range within one page is contiguous in memory.  Let the
+       * caller fall back to a RAM copy of the file otherwise.
+       */
+
+      if (offset + map->length > TMPFS_PAGESIZE)
+        {
+          return -ENOTTY;
+        }
+
+      tmpfs_lock_file(tfo);
+      page = tmpfs_file_page(tfo, map->offset / TMPFS_PAGESIZE);
+      tmpfs_unlock_file(tfo);
+      if (page == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      map->vaddr = page + offset;
+#else
       map->vaddr = tfo->tfo_data + map->offset;
+#endif
       map->priv.p = tfo;
       map->munmap = tmpfs_unmap;
       ret = mm_map_add(get_current_mm(), map);
@@ -1842,7 +2093,31 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     {
       FAR uintptr_t *ptr = (FAR uintptr_t *)arg;
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+      FAR uint8_t *page = NULL;
+
+      /* Only a file that fits in its first page is contiguous */
+
+      if (tfo->tfo_size > TMPFS_PAGESIZE)
+        {
+          return -ENOTTY;
+        }
+
+      if (tfo->tfo_size > 0)
+        {
+          tmpfs_lock_file(tfo);
+          page = tmpfs_file_page(tfo, 0);
+          tmpfs_unlock_file(tfo);
+          if (page == NULL)
+            {
+              return -ENOMEM;
+            }
+        }
+
+      *ptr = (uintptr_t)page;
+#else
       *ptr = (uintptr_t)tfo->tfo_data;
+#endif
       return OK;
     }
 
@@ -1976,14 +2251,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
           goto errout_with_lock;
         }
 
+#ifndef CONFIG_FS_TMPFS_PAGED
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  With paged storage the new range is a hole instead.
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2426,7 +2703,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       fs_heap_free(tfo);
     }
 
@@ -128,7 +128,12 @@ struct tmpfs_file_s
 
   uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
   size_t        tfo_size;  /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_PAGED
+  size_t        tfo_npages; /* Number of entries in tfo_pages */
+  FAR uint8_t **tfo_pages;  /* File data pages, NULL for a hole */
+#else
   FAR uint8_t  *tfo_data;  /* File data starts here */
+#endif
 };
 
 /* This structure represents one instance of a TMPFS file system */
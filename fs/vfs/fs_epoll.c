@@ -42,6 +42,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -53,6 +54,7 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rnode;    /* Link in the ready list */
   epoll_data_t             data;
   bool                     notified;
   struct pollfd            pfd;
@@ -67,6 +69,13 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rlock;    /* Protects the ready list, it is also
+                                   * updated by the poll callbacks.
+                                   */
+  struct list_node      ready;    /* The ready list, store the setuped epoll
+                                   * node notified since it was setuped,
+                                   * epoll_wait() only looks at these.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
                                    * epoll node.
                                    */
@@ -242,6 +251,8 @@ static int epoll_do_create(int size, int flags)
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  spin_lock_init(&eph->rlock);
+  list_initialize(&eph->ready);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -339,23 +350,35 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
+  FAR struct list_node *rnode;
   FAR epoll_node_t *epn;
+  irqstate_t flags;
+  bool pending;
+  int semcount = 0;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  /* Only the notified fds are on the ready list, so this does not depend
+   * on the number of fds being watched.
+   */
+
+  while (i < maxevents)
     {
-      /* Only check the notifed fd */
+      flags = spin_lock_irqsave(&eph->rlock);
+      rnode = list_remove_head(&eph->ready);
+      spin_unlock_irqrestore(&eph->rlock, flags);
 
-      if (!epn->notified)
+      if (rnode == NULL)
         {
-          continue;
+          break;
         }
 
-      /* Teradown all the notified fd */
+      /* Teradown the notified fd.  It stays marked as notified, so that it
+       * is not put on the ready list again until it is setup again.
+       */
 
+      epn = container_of(rnode, epoll_node_t, rnode);
       poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
       list_delete(&epn->node);
 
@@ -378,10 +401,56 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
         }
     }
 
+  /* The fds left on the ready list remain setuped, make sure that the next
+   * epoll_wait() does not block before reporting them.
+   */
+
+  flags   = spin_lock_irqsave(&eph->rlock);
+  pending = !list_is_empty(&eph->ready);
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (pending)
+    {
+      nxsem_get_value(&eph->sem, &semcount);
+      if (semcount < 1)
+        {
+          nxsem_post(&eph->sem);
+        }
+    }
+
   nxmutex_unlock(&eph->lock);
   return i;
 }
 
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a setuped epoll node from the ready list after it has been
+ *   teardown.
+ *
+ * Input Parameters:
+ *   eph       - The epoll head pointer
+ *   epn       - The epoll node
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (list_in_list(&epn->rnode))
+    {
+      list_delete(&epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
 /****************************************************************************
  * Name: epoll_default_cb
  *
@@ -400,9 +469,21 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
   int semcount = 0;
 
-  epn->notified = true;
+  /* Queue the node on the ready list the first time it is notified */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (!epn->notified)
+    {
+      epn->notified = true;
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
   if (fds->revents != 0)
     {
       nxsem_get_value(&epn->eph->sem, &semcount);
@@ -582,6 +663,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 poll_fdsetup(fd, &epn->pfd, false);
+                epoll_unready(eph, epn);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
                 goto out;
@@ -619,6 +701,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
                     poll_fdsetup(fd, &epn->pfd, false);
+                    epoll_unready(eph, epn);
 
                     epn->notified    = false;
                     epn->data        = ev->data;
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/epoll.h>
 #include <poll.h>
 #include <time.h>
 #include <assert.h>
@@ -276,6 +277,7 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
 {
   int i;
   FAR struct pollfd *fds;
+  bool exclusive = false;
 
   DEBUGASSERT(afds != NULL && nfds >= 1);
 
@@ -284,6 +286,22 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
       fds = afds[i];
       if (fds != NULL)
         {
+          /* Only the first of the exclusive waiters on the same file is
+           * woken up by each notification, unless it reports an error or
+           * a hang up.
+           */
+
+          if ((fds->events & EPOLLEXCLUSIVE) != 0 &&
+              (eventset & (POLLERR | POLLHUP)) == 0)
+            {
+              if (exclusive)
+                {
+                  continue;
+                }
+
+              exclusive = (eventset & fds->events) != 0;
+            }
+
           /* The error event must be set in fds->revents */
 
           fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
@@ -421,6 +439,9 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
 int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
 {
+#if defined(CONFIG_BUILD_KERNEL) && CONFIG_FS_POLL_STACKFDS > 0
+  struct pollfd stackfds[CONFIG_FS_POLL_STACKFDS];
+#endif
   FAR struct pollfd *kfds;
   sem_t sem;
   int count = 0;
@@ -433,9 +454,21 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
   enter_cancellation_point();
 
 #ifdef CONFIG_BUILD_KERNEL
-  /* Allocate kernel memory for the fds */
+  /* Allocate kernel memory for the fds, small lists are kept on the
+   * stack.
+   */
+
+#if CONFIG_FS_POLL_STACKFDS > 0
+  if (nfds <= CONFIG_FS_POLL_STACKFDS)
+    {
+      kfds = stackfds;
+    }
+  else
+#endif
+    {
+      kfds = fs_heap_malloc(nfds * sizeof(struct pollfd));
+    }
 
-  kfds = fs_heap_malloc(nfds * sizeof(struct pollfd));
   if (!kfds)
     {
       /* Out of memory */
@@ -542,7 +575,12 @@ int poll(FAR struct pollfd *fds, nfds_t nfds, int timeout)
 
   /* Free the temporary buffer */
 
-  fs_heap_free(kfds);
+#if CONFIG_FS_POLL_STACKFDS > 0
+  if (kfds != stackfds)
+#endif
+    {
+      fs_heap_free(kfds);
+    }
 
 out_with_cancelpt:
 #endif
@@ -70,6 +70,7 @@ static int pseudorename(FAR const char *oldpath, FAR struct inode *oldinode,
 {
   struct inode_search_s newdesc;
   FAR struct inode *newinode;
+  FAR struct inode *child;
   FAR char *subdir = NULL;
 #ifdef CONFIG_FS_NOTIFY
   bool isdir = INODE_IS_PSEUDODIR(oldinode);
@@ -208,6 +209,15 @@ next_subdir:
 #endif
   newinode->i_private = oldinode->i_private; /* Per inode driver private data */
 
+  /* The children now belong to the new inode */
+
+  for (child = newinode->i_child; child != NULL; child = child->i_peer)
+    {
+      inode_hash_remove(child);
+      child->i_parent = newinode;
+      inode_hash_insert(child);
+    }
+
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   /* Prevent the link target string from being deallocated.  The pointer to
    * the allocated link target path was copied above (under the guise of
@@ -91,6 +91,9 @@
 int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
            FAR fd_set *exceptfds, FAR struct timeval *timeout)
 {
+#if CONFIG_FS_POLL_STACKFDS > 0
+  struct pollfd stackset[CONFIG_FS_POLL_STACKFDS];
+#endif
   struct pollfd *pollset = NULL;
   int fd;
   int npfds;
@@ -126,8 +129,18 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
         }
     }
 
-  /* Allocate the descriptor list for poll() */
+  /* Allocate the descriptor list for poll(), small lists are kept on the
+   * stack.
+   */
 
+#if CONFIG_FS_POLL_STACKFDS > 0
+  if (npfds > 0 && npfds <= CONFIG_FS_POLL_STACKFDS)
+    {
+      pollset = stackset;
+      memset(pollset, 0, npfds * sizeof(struct pollfd));
+    }
+  else
+#endif
   if (npfds > 0)
     {
       pollset = (FAR struct pollfd *)
@@ -280,6 +293,12 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
         }
     }
 
-  fs_heap_free(pollset);
+#if CONFIG_FS_POLL_STACKFDS > 0
+  if (pollset != stackset)
+#endif
+    {
+      fs_heap_free(pollset);
+    }
+
   return ret;
 }
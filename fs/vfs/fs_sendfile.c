@@ -27,7 +27,10 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -233,10 +236,148 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
   return ntransferred;
 }
 
+/****************************************************************************
+ * Name: copyfile_xip
+ *
+ * Description:
+ *   If the input file data is addressable and immutable (file_xipbase()),
+ *   write it to the output file straight from there without the
+ *   intermediate buffer.  -ENOTTY is returned if that is not
+ *   possible and the data has to be copied by copyfile().
+ *
+ ****************************************************************************/
+
+static ssize_t copyfile_xip(FAR struct file *outfile,
+                            FAR struct file *infile,
+                            FAR off_t *offset, size_t count)
+{
+  FAR const uint8_t *base;
+  size_t ntransferred = 0;
+  ssize_t ret;
+  off_t size;
+  off_t pos;
+
+  /* Writing into the input file itself could move its data */
+
+  if (outfile->f_inode == infile->f_inode)
+    {
+      return -ENOTTY;
+    }
+
+  base = file_xipbase(infile, &size);
+  if (base == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  pos = offset ? *offset : file_seek(infile, 0, SEEK_CUR);
+  if (pos < 0)
+    {
+      return pos;
+    }
+
+  if (pos >= size)
+    {
+      count = 0;
+    }
+  else if (count > size - pos)
+    {
+      count = size - pos;
+    }
+
+  base += pos;
+  while (ntransferred < count)
+    {
+      ret = file_write(outfile, base + ntransferred, count - ntransferred);
+      if (ret < 0)
+        {
+          /* Report the error only if nothing was written */
+
+          if (ntransferred == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+
+      ntransferred += ret;
+    }
+
+  /* Advance the file position (or the caller's offset) as a read would */
+
+  pos += ntransferred;
+  if (offset)
+    {
+      *offset = pos;
+    }
+  else
+    {
+      pos = file_seek(infile, pos, SEEK_SET);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  return ntransferred;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: file_xipbase
+ *
+ * Description:
+ *   Return the address of the file data if it may be used in place for as
+ *   long as the file is open.  FIOC_XIPBASE alone does not promise that:
+ *   a tmpfs file can be written, truncated or unlinked (and its buffer
+ *   reallocated or freed) while a consumer is still reading it.  Only
+ *   mounted file systems that cannot modify or remove files at all (e.g.
+ *   ROMFS on XIP media) qualify.  The mount point cannot go away either,
+ *   because umount() fails while the file is open.
+ *
+ * Input Parameters:
+ *   filep - The input file
+ *   size  - Location to return the size of the file
+ *
+ * Returned Value:
+ *   The address of the first byte of the file, or NULL if the data has to
+ *   be read through the file system.
+ *
+ ****************************************************************************/
+
+FAR const void *file_xipbase(FAR struct file *filep, FAR off_t *size)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR const struct mountpt_operations *mops;
+  uintptr_t base = 0;
+  struct stat st;
+
+  if (inode == NULL || !INODE_IS_MOUNTPT(inode))
+    {
+      return NULL;
+    }
+
+  mops = inode->u.i_mops;
+  if (mops == NULL || mops->write != NULL || mops->writev != NULL ||
+      mops->truncate != NULL || mops->unlink != NULL)
+    {
+      return NULL;
+    }
+
+  if (file_ioctl(filep, FIOC_XIPBASE, (unsigned long)&base) < 0 ||
+      base == 0 || file_fstat(filep, &st) < 0)
+    {
+      return NULL;
+    }
+
+  *size = st.st_size;
+  return (FAR const void *)base;
+}
+
 /****************************************************************************
  * Name: file_sendfile
  *
@@ -249,6 +390,8 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count)
 {
+  ssize_t ret;
+
   if (count == 0)
     {
       nwarn("WARNING: sendfile count is zero\n");
@@ -267,7 +410,7 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
     {
       /* Then let psock_sendfile do the work. */
 
-      int ret = psock_sendfile(psock, infile, offset, count);
+      ret = psock_sendfile(psock, infile, offset, count);
       if (ret >= 0 || ret != -ENOSYS)
         {
           return ret;
@@ -283,9 +426,77 @@ ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
    * copyfile() can handle that case.
    */
 
+  ret = copyfile_xip(outfile, infile, offset, count);
+  if (ret != -ENOTTY)
+    {
+      return ret;
+    }
+
   return copyfile(outfile, infile, offset, count);
 }
 
+/****************************************************************************
+ * Name: file_copy_file_range
+ *
+ * Description:
+ *   Equivalent to the standard copy_file_range() function except that is
+ *   accepts struct file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_copy_file_range(FAR struct file *infile, FAR off_t *off_in,
+                             FAR struct file *outfile, FAR off_t *off_out,
+                             size_t len, unsigned int flags)
+{
+  off_t outpos = 0;
+  ssize_t ret;
+
+  if (flags != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  /* Write at *off_out without changing the output file position */
+
+  if (off_out)
+    {
+      outpos = file_seek(outfile, 0, SEEK_CUR);
+      if (outpos < 0)
+        {
+          return outpos;
+        }
+
+      ret = file_seek(outfile, *off_out, SEEK_SET);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  ret = copyfile_xip(outfile, infile, off_in, len);
+  if (ret == -ENOTTY)
+    {
+      ret = copyfile(outfile, infile, off_in, len);
+    }
+
+  if (off_out)
+    {
+      if (ret > 0)
+        {
+          *off_out += ret;
+        }
+
+      file_seek(outfile, outpos, SEEK_SET);
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: sendfile
  *
@@ -364,3 +575,65 @@ errout:
   set_errno(-ret);
   return ERROR;
 }
+
+/****************************************************************************
+ * Name: copy_file_range
+ *
+ * Description:
+ *   copy_file_range() copies up to 'len' bytes from 'fd_in' to 'fd_out'.
+ *   If 'off_in' (or 'off_out') is NULL, the current file position of the
+ *   descriptor is used and advanced; otherwise the data is read (written)
+ *   at the offset it points to, the offset is advanced by the number of
+ *   bytes copied and the file position is left unchanged.
+ *
+ *   When the input file system exposes the file data in memory (e.g. ROMFS
+ *   on XIP media), the data is written directly from there.
+ *
+ * Input Parameters:
+ *   fd_in   - The file descriptor to read from
+ *   off_in  - The input offset or NULL
+ *   fd_out  - The file descriptor to write to
+ *   off_out - The output offset or NULL
+ *   len     - The number of bytes to copy
+ *   flags   - Reserved, must be zero
+ *
+ * Returned Value:
+ *   The number of bytes copied, which may be less than requested.  On
+ *   error, -1 is returned, and errno is set appropriately.
+ *
+ ****************************************************************************/
+
+ssize_t copy_file_range(int fd_in, FAR off_t *off_in, int fd_out,
+                        FAR off_t *off_out, size_t len, unsigned int flags)
+{
+  FAR struct file *outfile;
+  FAR struct file *infile;
+  ssize_t ret;
+
+  ret = fs_getfilep(fd_out, &outfile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = fs_getfilep(fd_in, &infile);
+  if (ret < 0)
+    {
+      fs_putfilep(outfile);
+      goto errout;
+    }
+
+  ret = file_copy_file_range(infile, off_in, outfile, off_out, len, flags);
+  fs_putfilep(outfile);
+  fs_putfilep(infile);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return ret;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
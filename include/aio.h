@@ -163,6 +163,10 @@ int aio_write(FAR struct aiocb *aiocbp);
 int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
                FAR struct sigevent *sig);
 
+/* Non-standard: the batched submission used by lio_listio() */
+
+int lio_submit(FAR struct aiocb * const list[], int nent);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -31,6 +31,21 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Sector cache statistics of a BCH instance (see BIOC_BCHSTATS) */
+
+struct bch_cachestats_s
+{
+  uint32_t hits;           /* Sector accesses served from the cache */
+  uint32_t misses;         /* Sector accesses that read the device */
+  uint32_t readahead;      /* Sectors read ahead of a sequential miss */
+  uint32_t flushes;        /* Write requests issued to the device */
+};
 
 /****************************************************************************
  * Public Function Prototypes
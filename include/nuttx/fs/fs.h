@@ -418,6 +418,9 @@ struct inode
   struct timespec   i_atime;    /* Time of last access */
   struct timespec   i_mtime;    /* Time of last modification */
   struct timespec   i_ctime;    /* Time of last status change */
+#endif
+#ifdef CONFIG_PSEUDOFS_INODE_HASH
+  FAR struct inode *i_hnext;    /* Link to next inode in hash bucket */
 #endif
   FAR void         *i_private;  /* Per inode driver private data */
   char              i_name[1];  /* Name of inode (variable) */
@@ -1541,6 +1544,31 @@ ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf,
 ssize_t file_sendfile(FAR struct file *outfile, FAR struct file *infile,
                       FAR off_t *offset, size_t count);
 
+/****************************************************************************
+ * Name: file_xipbase
+ *
+ * Description:
+ *   Return the address of the file data if the file system exposes it
+ *   (FIOC_XIPBASE) and can never change it while the file is open, NULL
+ *   otherwise.  The size of the file is returned in 'size'.
+ *
+ ****************************************************************************/
+
+FAR const void *file_xipbase(FAR struct file *filep, FAR off_t *size);
+
+/****************************************************************************
+ * Name: file_copy_file_range
+ *
+ * Description:
+ *   Equivalent to the standard copy_file_range() function except that is
+ *   accepts struct file instances instead of file descriptors.
+ *
+ ****************************************************************************/
+
+ssize_t file_copy_file_range(FAR struct file *infile, FAR off_t *off_in,
+                             FAR struct file *outfile, FAR off_t *off_out,
+                             size_t len, unsigned int flags);
+
 /****************************************************************************
  * Name: file_seek
  *
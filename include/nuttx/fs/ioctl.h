@@ -348,6 +348,12 @@
                                            *      to return sector numbers.
                                            * OUT: Data return in user-provided
                                            *      buffer. */
+#define BIOC_BCHSTATS   _BIOC(0x0011)     /* Used only by BCH to return the
+                                           * statistics of its sector cache.
+                                           * IN:  Pointer to writable instance
+                                           *      of struct bch_cachestats_s
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
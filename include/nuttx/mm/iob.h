@@ -102,6 +102,14 @@
 
 typedef CODE void (*iob_free_cb_t)(FAR void *data);
 
+/* Copies 'len' bytes from 'src' to 'dest' for iob_copyin_fn() and
+ * iob_clone_partial_fn(), e.g. to checksum the data in the same pass.
+ * The blocks are passed in data order.
+ */
+
+typedef CODE void (*iob_copyfn_t)(FAR void *arg, FAR uint8_t *dest,
+                                  FAR const uint8_t *src, unsigned int len);
+
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
@@ -476,6 +484,19 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled);
 
+/****************************************************************************
+ * Name: iob_copyin_fn
+ *
+ * Description:
+ *  Same as iob_copyin(), or iob_trycopyin() if 'can_block' is false, but
+ *  the data is moved with 'copyfn' instead of memcpy().
+ *
+ ****************************************************************************/
+
+int iob_copyin_fn(FAR struct iob_s *iob, FAR const uint8_t *src,
+                  unsigned int len, int offset, bool throttled,
+                  bool can_block, iob_copyfn_t copyfn, FAR void *arg);
+
 /****************************************************************************
  * Name: iob_copyout
  *
@@ -535,6 +556,20 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
                       int offset1, FAR struct iob_s *iob2,
                       int offset2, bool throttled, bool block);
 
+/****************************************************************************
+ * Name: iob_clone_partial_fn
+ *
+ * Description:
+ *   Same as iob_clone_partial(), but the data is moved with 'copyfn'
+ *   instead of memcpy().
+ *
+ ****************************************************************************/
+
+int iob_clone_partial_fn(FAR struct iob_s *iob1, unsigned int len,
+                         int offset1, FAR struct iob_s *iob2,
+                         int offset2, bool throttled, bool block,
+                         iob_copyfn_t copyfn, FAR void *arg);
+
 /****************************************************************************
  * Name: iob_concat
  *
@@ -87,6 +87,18 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+/* Per-CPU stack of free blocks, only touched by its own CPU with local
+ * interrupts disabled.
+ */
+
+struct mempool_cache_s
+{
+  size_t    count;
+  FAR void *blks[CONFIG_MM_MEMPOOL_PERCPU_CACHE_SIZE];
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -110,6 +122,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  struct mempool_cache_s cache[CONFIG_SMP_NCPUS]; /* Per-CPU free blocks */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -298,6 +298,14 @@ struct netdev_rss_s
 };
 #endif // CONFIG_NETDEV_RSS
 
+/* Running Internet checksum state used by chksum_copy() */
+
+struct chksum_copy_s
+{
+  uint16_t sum;  /* Sum of the data copied so far, as returned by chksum() */
+  bool     odd;  /* True if an odd number of bytes was copied so far */
+};
+
 /* This structure collects information that is specific to a specific network
  * interface driver.  If the hardware platform supports only a single
  * instance of this structure.
@@ -339,6 +347,19 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* TCP segmentation offload.  A driver that can split oversized IPv4 TCP
+   * packets sets d_gsosize to the largest such packet it accepts
+   * (including the link layer header); zero disables offload.  d_gsomss
+   * is set by TCP to the segment size of the packet being sent and is
+   * cleared by netdev_iob_prepare() and netdev_iob_replace() for every
+   * other packet.
+   */
+
+  uint16_t d_gsosize;           /* Maximum segmentation offload packet size */
+  uint16_t d_gsomss;            /* Segment size of the outgoing packet */
+#endif
+
   /* Link layer address */
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
@@ -474,6 +495,16 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+  /* If d_sndsumlen is non-zero and equal to d_sndlen, d_sndsum holds the
+   * chksum() of the d_sndlen bytes of application data at the end of the
+   * packet, computed while they were copied into d_iob.  The TCP or UDP
+   * checksum then only needs to sum the headers; computing it consumes the
+   * recorded sum, so no other packet built in d_iob can pick it up.
+   */
+
+  uint16_t d_sndsum;
+  uint16_t d_sndsumlen;
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -810,6 +841,26 @@ void netdev_carrier_off(FAR struct net_driver_s *dev);
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy 'len' bytes from 'src' to 'dest' and add them to the running
+ *   checksum in 'arg', a struct chksum_copy_s, in the same pass.  The
+ *   prototype matches iob_copyfn_t.
+ *
+ * Input Parameters:
+ *   arg  - The struct chksum_copy_s holding the running sum.  Zero it
+ *          before the first block.
+ *   dest - Destination of the copy.
+ *   src  - Source of the copy.
+ *   len  - Number of bytes to copy.
+ *
+ ****************************************************************************/
+
+void chksum_copy(FAR void *arg, FAR uint8_t *dest,
+                 FAR const uint8_t *src, unsigned int len);
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -84,6 +84,19 @@
 typedef struct iob_s netpkt_t;
 typedef struct iob_queue_s netpkt_queue_t;
 
+/* Per-queue counters, kept by the upper half when the lower half declares
+ * more than one queue.
+ */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+struct netdev_queue_stats_s
+{
+  uint32_t packets;  /* Packets passed through the queue */
+  uint32_t bytes;    /* Bytes passed through the queue */
+  uint32_t errors;   /* Packets the lower half refused */
+};
+#endif
+
 enum netpkt_type_e
 {
   NETPKT_TX,
@@ -119,6 +132,18 @@ struct netdev_lowerhalf_s
 
   atomic_t quota[NETPKT_TYPENUM];
 
+  /* Number of RX/TX queues, 0 or 1 for a single queue device.  Must be
+   * set before netdev_lower_register and not exceed NETDEV_MAX_QUEUES.
+   */
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  uint8_t rxqueues;
+  uint8_t txqueues;
+
+  struct netdev_queue_stats_s rxstats[CONFIG_NETDEV_MAX_QUEUES];
+  struct netdev_queue_stats_s txstats[CONFIG_NETDEV_MAX_QUEUES];
+#endif
+
   /* The structure used by net stack.
    * Note: Do not change its fields unless you know what you are doing.
    *
@@ -172,6 +197,19 @@ struct netdev_ops_s
   /* reclaim - try to reclaim packets sent by netdev. */
 
   CODE void (*reclaim)(FAR struct netdev_lowerhalf_s *dev);
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  /* transmit_queue - Like transmit, but send on the given TX queue.
+   * receive_queue  - Like receive, but take from the given RX queue.
+   *   Optional, used instead of transmit/receive when the device has more
+   *   than one queue.  Each RX queue is only polled by one thread.
+   */
+
+  CODE int (*transmit_queue)(FAR struct netdev_lowerhalf_s *dev,
+                             FAR netpkt_t *pkt, int queue);
+  CODE FAR netpkt_t *(*receive_queue)(FAR struct netdev_lowerhalf_s *dev,
+                                      int queue);
+#endif
 };
 
 /* This structure is a set of wireless handlers, leave unsupported operations
@@ -295,6 +333,42 @@ void netdev_lower_carrier_off(FAR struct netdev_lowerhalf_s *dev);
 
 void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer that packets are ready to read on one
+ *   RX queue.  Only the thread the queue is steered to is woken.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The RX queue with packets ready
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue);
+
+/****************************************************************************
+ * Name: netdev_lower_flowhash
+ *
+ * Description:
+ *   Hash the addresses and ports of an IPv4 or IPv6 packet, for lower
+ *   halves that spread received packets over their queues in software.
+ *   Both directions of a flow hash to the same value.
+ *
+ * Input Parameters:
+ *   pkt - The packet, as passed to transmit or returned by receive
+ *
+ * Returned Value:
+ *   The flow hash, 0 if the packet is not IP.
+ *
+ ****************************************************************************/
+
+uint32_t netdev_lower_flowhash(FAR netpkt_t *pkt);
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_txdone
  *
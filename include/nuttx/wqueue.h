@@ -261,7 +261,25 @@ struct work_s
   worker_t  worker;              /* Work callback */
   FAR void *arg;                 /* Callback argument */
   FAR struct kwork_wqueue_s *wq; /* Work queue */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  clock_t   stime;               /* perf_gettime() when queued */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  uint8_t   cpu;                 /* CPU whose pending list holds the work */
+#endif
+};
+
+/* Queueing statistics of one kernel work queue, see work_queue_stats() */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stats_s
+{
+  uint32_t nworks;               /* Number of work items run */
+  uint32_t nsteals;              /* Work taken from another CPU's list */
+  uint64_t latency;              /* Total time pending (perf counts) */
+  uint64_t maxlatency;           /* Longest time pending (perf counts) */
 };
+#endif
 
 /* This is an enumeration of the various events that may be
  * notified via work_notifier_signal().
@@ -417,6 +435,59 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
                   FAR struct work_s *work, worker_t worker,
                   FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_cpu/work_queue_cpu_wq
+ *
+ * Description:
+ *   Like work_queue()/work_queue_wq(), but queue the work on the pending
+ *   list of the given CPU instead of the calling CPU's.  With
+ *   CONFIG_SCHED_WORKQUEUE_PERCPU the work is run by a worker thread
+ *   bound to that CPU unless all of them are busy and a worker of another
+ *   CPU steals it.  Otherwise the CPU is only checked for validity.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   wqueue - The work queue handle
+ *   cpu    - The CPU to queue the work on
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_cpu(int qid, int cpu, FAR struct work_s *work,
+                   worker_t worker, FAR void *arg, clock_t delay);
+int work_queue_cpu_wq(FAR struct kwork_wqueue_s *wqueue, int cpu,
+                      FAR struct work_s *work, worker_t worker,
+                      FAR void *arg, clock_t delay);
+
+/****************************************************************************
+ * Name: work_queue_stats/work_queue_stats_wq
+ *
+ * Description:
+ *   Return a snapshot of the queueing statistics of a work queue.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   wqueue - The work queue handle
+ *   stats  - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_queue_stats(int qid, FAR struct work_stats_s *stats);
+int work_queue_stats_wq(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: work_queue_pri
  *
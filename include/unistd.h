@@ -360,6 +360,8 @@ ssize_t pwrite(int fd, FAR const void *buf, size_t nbytes, off_t offset);
 int     ftruncate(int fd, off_t length);
 int     fchown(int fd, uid_t owner, gid_t group);
 int     lockf(int fd, int cmd, off_t len);
+ssize_t copy_file_range(int fd_in, FAR off_t *off_in, int fd_out,
+                        FAR off_t *off_out, size_t len, unsigned int flags);
 
 /* Check if a file descriptor corresponds to a terminal I/O file */
 
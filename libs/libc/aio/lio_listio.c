@@ -507,7 +507,7 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 {
   FAR struct aiocb *aiocbp = NULL;
   int nqueued;
-  int errcode;
+  int nreq = 0;
   int retcode;
   int status;
   int ret;
@@ -521,8 +521,7 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 
   DEBUGASSERT(list);
 
-  nqueued = 0;    /* No I/O operations yet queued */
-  ret     = OK;   /* Assume success */
+  ret = OK; /* Assume success */
 
   /* Lock the scheduler so that no I/O events can complete on the worker
    * thread until we set our wait set up.  Pre-emption will, of course, be
@@ -531,79 +530,26 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 
   sched_lock();
 
-  /* Submit each asynchronous I/O operation in the list, skipping over NULL
-   * entries.
+  /* Submit all asynchronous I/O operations in the list as one batch.  Each
+   * non-NULL entry other than LIO_NOP that was not accepted has its error
+   * recorded in aio_result.
    */
 
+  nqueued = lio_submit(list, nent);
   for (i = 0; i < nent; i++)
     {
-      /* Skip over NULL entries */
-
       aiocbp = list[i];
-      if (aiocbp)
+      if (aiocbp != NULL && aiocbp->aio_lio_opcode != LIO_NOP)
         {
-          /* Submit the operation according to its opcode */
-
-          status = OK;
-          switch (aiocbp->aio_lio_opcode)
-            {
-            case LIO_NOP:
-              {
-                /* Mark the do-nothing operation complete */
-
-                aiocbp->aio_result = OK;
-              }
-              break;
-
-            case LIO_READ:
-            case LIO_WRITE:
-              {
-                if (aiocbp->aio_lio_opcode == LIO_READ)
-                  {
-                    /* Submit the asynchronous read operation */
-
-                    status = aio_read(aiocbp);
-                  }
-                else
-                  {
-                    /* Submit the asynchronous write operation */
-
-                    status = aio_write(aiocbp);
-                  }
-
-                if (status < 0)
-                  {
-                    /* Failed to queue the I/O.  Set up the error return. */
-
-                    errcode = get_errno();
-                    ferr("ERROR: aio_read/write failed: %d\n", errcode);
-                    DEBUGASSERT(errcode > 0);
-                    aiocbp->aio_result = -errcode;
-                    ret = ERROR;
-                  }
-                else
-                  {
-                    /* Increment the count of successfully queue operations */
-
-                    nqueued++;
-                  }
-              }
-              break;
-
-            default:
-              {
-                /* Make the invalid operation complete with an error */
-
-                ferr("ERROR: Unrecognized opcode: %d\n",
-                     aiocbp->aio_lio_opcode);
-                aiocbp->aio_result = -EINVAL;
-                ret = ERROR;
-              }
-              break;
-            }
+          nreq++;
         }
     }
 
+  if (nqueued < nreq)
+    {
+      ret = ERROR;
+    }
+
   /* If there was any failure in queuing the I/O, EIO will be returned */
 
   retcode = EIO;
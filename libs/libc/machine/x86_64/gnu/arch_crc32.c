@@ -0,0 +1,247 @@
+/****************************************************************************
+ * libs/libc/machine/x86_64/gnu/arch_crc32.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* CRC32 (polynomial 0xedb88320, reflected) using carry-less multiplication.
+ *
+ * The buffer is folded 64 bytes at a time into four 128-bit accumulators,
+ * which are then folded into one, reduced to 64 bits and finally to the
+ * 32-bit CRC with a Barrett reduction.  The folding constants are the
+ * reflected values of x^(n) mod P described in Intel's "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/crc32.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CRC32_FOLD_R1     0x0154442bd4ll /* x^(4*128+32) mod P */
+#define CRC32_FOLD_R2     0x01c6e41596ll /* x^(4*128-32) mod P */
+#define CRC32_FOLD_R3     0x01751997d0ll /* x^(128+32) mod P */
+#define CRC32_FOLD_R4     0x00ccaa009ell /* x^(128-32) mod P */
+#define CRC32_FOLD_R5     0x0163cd6124ll /* x^64 mod P */
+#define CRC32_POLY        0x01db710641ll /* P */
+#define CRC32_MU          0x01f7011641ll /* x^64 / P */
+
+#define CRC32_MASK32      0xffffffffll
+
+#define clmul(a, b, imm)  __builtin_ia32_pclmulqdq128(a, b, imm)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef long long v2di_t __attribute__((vector_size(16)));
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crc32_load
+ ****************************************************************************/
+
+static inline v2di_t crc32_load(FAR const uint8_t *src)
+{
+  v2di_t v;
+
+  memcpy(&v, src, sizeof(v));
+  return v;
+}
+
+/****************************************************************************
+ * Name: crc32_fold
+ *
+ * Description:
+ *   Fold the 128-bit accumulator 'acc' forward over the distance encoded
+ *   in 'k' and add it to 'data'.
+ *
+ ****************************************************************************/
+
+static inline __attribute__((target("pclmul")))
+v2di_t crc32_fold(v2di_t acc, v2di_t k, v2di_t data)
+{
+  return clmul(acc, k, 0x00) ^ clmul(acc, k, 0x11) ^ data;
+}
+
+/****************************************************************************
+ * Name: crc32_barrett
+ *
+ * Description:
+ *   Reduce the 64-bit value 'x' modulo P and return the 32-bit remainder.
+ *
+ ****************************************************************************/
+
+static inline __attribute__((target("pclmul")))
+uint32_t crc32_barrett(v2di_t x)
+{
+  const v2di_t k =
+  {
+    CRC32_POLY, CRC32_MU
+  };
+
+  const v2di_t mask =
+  {
+    CRC32_MASK32, 0
+  };
+
+  v2di_t t;
+
+  t = clmul(x & mask, k, 0x10) & mask;
+  t = clmul(t, k, 0x00) ^ x;
+  return (uint32_t)((uint64_t)t[0] >> 32);
+}
+
+/****************************************************************************
+ * Name: crc32_word
+ *
+ * Description:
+ *   Feed 'bits' (8, 16 or 32) bits of 'data' into the CRC.
+ *
+ ****************************************************************************/
+
+static inline __attribute__((target("pclmul")))
+uint32_t crc32_word(uint32_t crc32val, uint32_t data, int bits)
+{
+  uint32_t rest = bits < 32 ? crc32val >> bits : 0;
+  v2di_t x =
+  {
+    (uint32_t)((crc32val ^ data) << (32 - bits)), 0
+  };
+
+  return crc32_barrett(x) ^ rest;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crc32part
+ *
+ * Description:
+ *   Continue CRC calculation on a part of the buffer.
+ *
+ ****************************************************************************/
+
+__attribute__((target("pclmul")))
+uint32_t crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val)
+{
+  if (len >= 64)
+    {
+      const v2di_t k12 =
+      {
+        CRC32_FOLD_R1, CRC32_FOLD_R2
+      };
+
+      const v2di_t k34 =
+      {
+        CRC32_FOLD_R3, CRC32_FOLD_R4
+      };
+
+      const v2di_t k5 =
+      {
+        CRC32_FOLD_R5, 0
+      };
+
+      const v2di_t mask =
+      {
+        CRC32_MASK32, 0
+      };
+
+      v2di_t x0 = crc32_load(src);
+      v2di_t x1 = crc32_load(src + 16);
+      v2di_t x2 = crc32_load(src + 32);
+      v2di_t x3 = crc32_load(src + 48);
+      v2di_t t;
+
+      x0[0] ^= crc32val;
+      src += 64;
+      len -= 64;
+
+      /* Fold four lanes of 16 bytes in parallel */
+
+      while (len >= 64)
+        {
+          x0 = crc32_fold(x0, k12, crc32_load(src));
+          x1 = crc32_fold(x1, k12, crc32_load(src + 16));
+          x2 = crc32_fold(x2, k12, crc32_load(src + 32));
+          x3 = crc32_fold(x3, k12, crc32_load(src + 48));
+          src += 64;
+          len -= 64;
+        }
+
+      /* Fold the four lanes into one, then the remaining 16-byte blocks */
+
+      x0 = crc32_fold(x0, k34, x1);
+      x0 = crc32_fold(x0, k34, x2);
+      x0 = crc32_fold(x0, k34, x3);
+
+      while (len >= 16)
+        {
+          x0 = crc32_fold(x0, k34, crc32_load(src));
+          src += 16;
+          len -= 16;
+        }
+
+      /* 128 -> 64 bits, appending 32 zero bits, then Barrett to 32 bits */
+
+      t = clmul(x0, k34, 0x10);
+      x0[0] = x0[1];
+      x0[1] = 0;
+      x0 ^= t;
+
+      t[0] = ((uint64_t)x0[0] >> 32) | ((uint64_t)x0[1] << 32);
+      t[1] = (uint64_t)x0[1] >> 32;
+      x0 = clmul(x0 & mask, k5, 0x00) ^ t;
+
+      crc32val = crc32_barrett(x0);
+    }
+
+  while (len >= 4)
+    {
+      uint32_t data;
+
+      memcpy(&data, src, sizeof(data));
+      crc32val = crc32_word(crc32val, data, 32);
+      src += 4;
+      len -= 4;
+    }
+
+  while (len-- > 0)
+    {
+      crc32val = crc32_word(crc32val, *src++, 8);
+    }
+
+  return crc32val;
+}
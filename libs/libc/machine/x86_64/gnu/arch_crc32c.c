@@ -0,0 +1,71 @@
+/****************************************************************************
+ * libs/libc/machine/x86_64/gnu/arch_crc32c.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* CRC-32C using the SSE4.2 crc32 instruction, eight bytes at a time */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/crc32.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crc32cpart
+ *
+ * Description:
+ *   Continue CRC-32C calculation on a part of the buffer.
+ *
+ ****************************************************************************/
+
+__attribute__((target("sse4.2")))
+uint32_t crc32cpart(FAR const uint8_t *src, size_t len, uint32_t crc32val)
+{
+  uint64_t crc = crc32val;
+
+  while (len >= 8)
+    {
+      uint64_t data;
+
+      memcpy(&data, src, sizeof(data));
+      crc = __builtin_ia32_crc32di(crc, data);
+      src += 8;
+      len -= 8;
+    }
+
+  crc32val = (uint32_t)crc;
+  while (len-- > 0)
+    {
+      crc32val = __builtin_ia32_crc32qi(crc32val, *src++);
+    }
+
+  return crc32val;
+}
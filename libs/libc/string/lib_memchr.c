@@ -26,9 +26,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
 #include "libc.h"
+#include "string/lib_string.h"
 
 /****************************************************************************
  * Public Functions
@@ -53,10 +55,38 @@
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
+  unsigned char ch = (unsigned char)c;
+
+  while (UNALIGNED(p) != 0 && n > 0)
+    {
+      if (*p == ch)
+        {
+          return (FAR void *)p;
+        }
+
+      p++;
+      n--;
+    }
+
+  /* Skip whole words that do not contain the byte */
+
+  if (n >= WORDSIZE)
+    {
+      FAR const uintptr_t *w = (FAR const uintptr_t *)p;
+      uintptr_t mask = ONES * ch;
+
+      while (n >= WORDSIZE && !DETECTNULL(*w ^ mask))
+        {
+          w++;
+          n -= WORDSIZE;
+        }
+
+      p = (FAR const unsigned char *)w;
+    }
 
   while (n--)
     {
-      if (*p == (unsigned char)c)
+      if (*p == ch)
         {
           return (FAR void *)p;
         }
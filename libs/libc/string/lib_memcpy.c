@@ -26,9 +26,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "libc.h"
+#include "string/lib_string.h"
 
 /****************************************************************************
  * Public Functions
@@ -45,6 +47,44 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+  /* Copy a word at a time if both pointers reach word alignment together */
+
+  if (UNALIGNED((uintptr_t)pout ^ (uintptr_t)pin) == 0)
+    {
+      FAR uintptr_t *wout;
+      FAR uintptr_t *win;
+
+      while (UNALIGNED(pout) != 0 && n > 0)
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+      win  = (FAR uintptr_t *)pin;
+
+      while (n >= 4 * WORDSIZE)
+        {
+          wout[0] = win[0];
+          wout[1] = win[1];
+          wout[2] = win[2];
+          wout[3] = win[3];
+          wout   += 4;
+          win    += 4;
+          n      -= 4 * WORDSIZE;
+        }
+
+      while (n >= WORDSIZE)
+        {
+          *wout++ = *win++;
+          n      -= WORDSIZE;
+        }
+
+      pout = (FAR unsigned char *)wout;
+      pin  = (FAR unsigned char *)win;
+    }
+
   while (n-- > 0)
     {
       *pout++ = *pin++;
@@ -26,9 +26,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
 #include "libc.h"
+#include "string/lib_string.h"
 
 /****************************************************************************
  * Public Functions
@@ -50,11 +52,36 @@
 
 #if !defined(CONFIG_LIBC_ARCH_STRCHR) && defined(LIBC_BUILD_STRCHR)
 #undef strchr /* See mm/README.txt */
+nosanitize_address
 FAR char *strchr(FAR const char *s, int c)
 {
-  for (; ; s++)
+  FAR const uintptr_t *w;
+  uintptr_t mask;
+
+  while (UNALIGNED(s) != 0)
+    {
+      if (*s == (char)c)
+        {
+          return (FAR char *)s;
+        }
+
+      if (*s == '\0')
+        {
+          return NULL;
+        }
+
+      s++;
+    }
+
+  /* Skip whole words holding neither the character nor the terminator */
+
+  mask = ONES * (unsigned char)c;
+  for (w = (FAR const uintptr_t *)s;
+       !DETECTNULL(*w) && !DETECTNULL(*w ^ mask); w++);
+
+  for (s = (FAR const char *)w; ; s++)
     {
-      if (*s == c)
+      if (*s == (char)c)
         {
           return (FAR char *)s;
         }
@@ -0,0 +1,53 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Word-at-a-time helpers for the generic lib_mem*.c and lib_str*.c
+ * routines.  Those are what a build gets when LIBC_STRING_OPTIMIZE is off,
+ * which is always the case without ALLOW_BSD_COMPONENTS.  The newlib
+ * derived lib_bsd*.c files keep their own copies so that they stay in
+ * sync with upstream.
+ */
+
+#define WORDSIZE      sizeof(uintptr_t)
+#define UNALIGNED(x)  ((uintptr_t)(x) & (WORDSIZE - 1))
+
+/* Nonzero if the word x contains a zero byte */
+
+#define ONES          (UINTPTR_MAX / 0xff)
+#define DETECTNULL(x) (((x) - ONES) & ~(x) & (ONES << 7))
+
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
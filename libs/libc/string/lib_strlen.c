@@ -26,9 +26,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "libc.h"
+#include "string/lib_string.h"
 
 /****************************************************************************
  * Public Functions
@@ -36,10 +38,29 @@
 
 #if !defined(CONFIG_LIBC_ARCH_STRLEN) && defined(LIBC_BUILD_STRLEN)
 #undef strlen /* See mm/README.txt */
+nosanitize_address
 size_t strlen(FAR const char *s)
 {
-  FAR const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+  FAR const char *sc = s;
+  FAR const uintptr_t *w;
+
+  while (UNALIGNED(sc) != 0)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+
+      sc++;
+    }
+
+  /* An aligned word never crosses a page, so reading past the terminator
+   * within the last word is safe.
+   */
+
+  for (w = (FAR const uintptr_t *)sc; !DETECTNULL(*w); w++);
+
+  for (sc = (FAR const char *)w; *sc != '\0'; sc++);
   return sc - s;
 }
 #endif
@@ -90,10 +90,11 @@ static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: iob_clone_partial
+ * Name: iob_clone_partial_fn
  *
  * Description:
- *   Duplicate the data from partial bytes of iob1 to iob2
+ *   Duplicate the data from partial bytes of iob1 to iob2, moving it with
+ *   'copyfn'
  *
  * Input Parameters:
  *   iob1      - Pointer to source iob_s
@@ -104,15 +105,19 @@ static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
  *   throttled - An indication of the IOB allocation is "throttled"
  *   block     - Flag of Enable/Disable nonblocking operation
  *
+ *   copyfn    - Copy function, or NULL to use memcpy()
+ *   arg       - Argument passed to copyfn
+ *
  * Returned Value:
  *   == 0  - Partial clone successfully.
  *   < 0   - No available to clone to destination iob.
  *
  ****************************************************************************/
 
-int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
-                      int offset1, FAR struct iob_s *iob2,
-                      int offset2, bool throttled, bool block)
+int iob_clone_partial_fn(FAR struct iob_s *iob1, unsigned int len,
+                         int offset1, FAR struct iob_s *iob2,
+                         int offset2, bool throttled, bool block,
+                         iob_copyfn_t copyfn, FAR void *arg)
 {
   FAR uint8_t *src;
   FAR uint8_t *dest;
@@ -189,7 +194,14 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
 
       len -= ncopy;
 
-      memcpy(dest, src, ncopy);
+      if (copyfn != NULL)
+        {
+          copyfn(arg, dest, src, ncopy);
+        }
+      else
+        {
+          memcpy(dest, src, ncopy);
+        }
 
       offset1      += ncopy;
       offset2      += ncopy;
@@ -237,6 +249,35 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
   return 0;
 }
 
+/****************************************************************************
+ * Name: iob_clone_partial
+ *
+ * Description:
+ *   Duplicate the data from partial bytes of iob1 to iob2
+ *
+ * Input Parameters:
+ *   iob1      - Pointer to source iob_s
+ *   len       - Number of bytes to copy
+ *   offset1   - Offset of source iobs_s
+ *   iob2      - Pointer to destination iob_s
+ *   offset2   - Offset of destination iobs_s
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *   block     - Flag of Enable/Disable nonblocking operation
+ *
+ * Returned Value:
+ *   == 0  - Partial clone successfully.
+ *   < 0   - No available to clone to destination iob.
+ *
+ ****************************************************************************/
+
+int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
+                      int offset1, FAR struct iob_s *iob2,
+                      int offset2, bool throttled, bool block)
+{
+  return iob_clone_partial_fn(iob1, len, offset1, iob2, offset2,
+                              throttled, block, NULL, NULL);
+}
+
 /****************************************************************************
  * Name: iob_clone
  *
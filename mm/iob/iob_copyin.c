@@ -54,7 +54,8 @@
 
 static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
                                unsigned int len, int offset,
-                               bool throttled, bool can_block)
+                               bool throttled, bool can_block,
+                               iob_copyfn_t copyfn, FAR void *arg)
 {
   FAR struct iob_s *head = iob;
   FAR struct iob_s *next;
@@ -161,7 +162,15 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       /* Copy from the user buffer to the I/O buffer.  */
 
-      memcpy(dest, src, ncopy);
+      if (copyfn != NULL)
+        {
+          copyfn(arg, dest, src, ncopy);
+        }
+      else
+        {
+          memcpy(dest, src, ncopy);
+        }
+
       iobinfo("iob=%p Copy %u bytes new len=%u\n",
               iob, ncopy, iob->io_len);
 
@@ -227,7 +236,8 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, true);
+  return iob_copyin_internal(iob, src, len, offset, throttled, true,
+                             NULL, NULL);
 }
 
 /****************************************************************************
@@ -243,5 +253,23 @@ int iob_copyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
                   unsigned int len, int offset, bool throttled)
 {
-  return iob_copyin_internal(iob, src, len, offset, throttled, false);
+  return iob_copyin_internal(iob, src, len, offset, throttled, false,
+                             NULL, NULL);
+}
+
+/****************************************************************************
+ * Name: iob_copyin_fn
+ *
+ * Description:
+ *  Same as iob_copyin(), or iob_trycopyin() if 'can_block' is false, but
+ *  the data is moved with 'copyfn' instead of memcpy().
+ *
+ ****************************************************************************/
+
+int iob_copyin_fn(FAR struct iob_s *iob, FAR const uint8_t *src,
+                  unsigned int len, int offset, bool throttled,
+                  bool can_block, iob_copyfn_t copyfn, FAR void *arg)
+{
+  return iob_copyin_internal(iob, src, len, offset, throttled, can_block,
+                             copyfn, arg);
 }
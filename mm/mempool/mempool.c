@@ -28,6 +28,7 @@
 #include <execinfo.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/kmalloc.h>
@@ -40,6 +41,20 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+#  define MEMPOOL_CACHE_SIZE   CONFIG_MM_MEMPOOL_PERCPU_CACHE_SIZE
+#  define MEMPOOL_CACHE_BATCH  (MEMPOOL_CACHE_SIZE / 2)
+
+/* Blocks sitting in a per-CPU cache would be invisible to a task waiting
+ * on waitsem, so such pools always go through the shared queue.
+ */
+
+#  define mempool_cache_enabled(pool) \
+     (!(pool)->wait || (pool)->expandsize != 0)
+#else
+#  define mempool_cache_count(pool) 0
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0xAAAAAAAA
 #define MEMPOOL_MAGIC_ALLOC 0x55555555
@@ -98,6 +113,107 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+/****************************************************************************
+ * Name: mempool_cache_alloc
+ *
+ * Description:
+ *   Take a free block from the cache of the current CPU, refilling the
+ *   cache from the shared queue first if it is empty.  Blocks in a cache
+ *   are already counted in nalloc.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_cache_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->count == 0)
+    {
+      spin_lock(&pool->lock);
+      while (cache->count < MEMPOOL_CACHE_BATCH)
+        {
+          blk = mempool_remove_queue(pool, &pool->queue);
+          if (blk == NULL)
+            {
+              break;
+            }
+
+          cache->blks[cache->count++] = blk;
+          pool->nalloc++;
+        }
+
+      spin_unlock(&pool->lock);
+    }
+
+  if (cache->count > 0)
+    {
+      blk = cache->blks[--cache->count];
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_cache_free
+ *
+ * Description:
+ *   Put a free block in the cache of the current CPU, draining half of
+ *   the cache back to the shared queue first if it is full.
+ *
+ ****************************************************************************/
+
+static void mempool_cache_free(FAR struct mempool_s *pool, FAR void *blk)
+{
+  FAR struct mempool_cache_s *cache;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->count == MEMPOOL_CACHE_SIZE)
+    {
+      spin_lock(&pool->lock);
+      while (cache->count > MEMPOOL_CACHE_SIZE - MEMPOOL_CACHE_BATCH)
+        {
+          sq_addlast(cache->blks[--cache->count], &pool->queue);
+          pool->nalloc--;
+        }
+
+      spin_unlock(&pool->lock);
+    }
+
+  cache->blks[cache->count++] = blk;
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_cache_count
+ *
+ * Description:
+ *   Return the number of free blocks held in all per-CPU caches.  The
+ *   result is only a snapshot since other CPUs keep using their caches.
+ *
+ ****************************************************************************/
+
+static size_t mempool_cache_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->cache[cpu].count;
+    }
+
+  return count;
+}
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -260,6 +376,10 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
+
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -344,6 +464,17 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  if (mempool_cache_enabled(pool))
+    {
+      blk = mempool_cache_alloc(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = mempool_remove_queue(pool, &pool->queue);
@@ -398,6 +529,9 @@ retry:
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+out:
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -424,8 +558,8 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -437,12 +571,26 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 
 #endif
 
-  pool->nalloc--;
-
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   memset(blk, MM_FREE_MAGIC, pool->blocksize);
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  /* Blocks of the interrupt pool must go back to iqueue */
+
+  if (mempool_cache_enabled(pool) &&
+      ((FAR char *)blk < pool->ibase ||
+       (FAR char *)blk >= pool->ibase + pool->interruptsize))
+    {
+      kasan_poison(blk, pool->blocksize);
+      mempool_cache_free(pool, blk);
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+  pool->nalloc--;
+
   if (pool->interruptsize > blocksize)
     {
       if ((FAR char *)blk >= pool->ibase &&
@@ -492,13 +640,15 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   irqstate_t flags;
+  size_t ncached;
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
   flags = spin_lock_irqsave(&pool->lock);
-  info->ordblks = sq_count(&pool->queue);
+  ncached = mempool_cache_count(pool);
+  info->ordblks = sq_count(&pool->queue) + ncached;
   info->iordblks = sq_count(&pool->iqueue);
-  info->aordblks = pool->nalloc;
+  info->aordblks = pool->nalloc - ncached;
   info->arena = sq_count(&pool->equeue) * sizeof(sq_entry_t) +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
@@ -536,7 +686,8 @@ mempool_info_task(FAR struct mempool_s *pool,
     {
       irqstate_t flags = spin_lock_irqsave(&pool->lock);
       size_t count = sq_count(&pool->queue) +
-                     sq_count(&pool->iqueue);
+                     sq_count(&pool->iqueue) +
+                     mempool_cache_count(pool);
 
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
@@ -544,8 +695,10 @@ mempool_info_task(FAR struct mempool_s *pool,
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = pool->nalloc - mempool_cache_count(pool);
+
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -614,6 +767,22 @@ int mempool_deinit(FAR struct mempool_s *pool)
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   FAR sq_entry_t *blk;
   size_t count = 0;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  int cpu;
+
+  /* Give the cached blocks back so that they are seen as free */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mempool_cache_s *cache = &pool->cache[cpu];
+
+      while (cache->count > 0)
+        {
+          sq_addlast(cache->blks[--cache->count], &pool->queue);
+          pool->nalloc--;
+        }
+    }
+#endif
 
   if (pool->nalloc != 0)
     {
@@ -163,8 +163,12 @@ struct arp_entry_s
 {
   in_addr_t                at_ipaddr;   /* IP address */
   struct ether_addr        at_ethaddr;  /* Hardware address */
-  clock_t                  at_time;     /* Time of last usage */
+  clock_t                  at_time;     /* Time of last update */
+  clock_t                  at_used;     /* Time of last lookup */
   FAR struct net_driver_s *at_dev;      /* The device driver structure */
+#ifdef CONFIG_NET_ARPTAB_HASH
+  FAR struct arp_entry_s  *at_hnext;    /* Next entry in the hash bucket */
+#endif
 };
 
 /****************************************************************************
@@ -52,6 +52,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 
+#include "netdev/netdev.h"
 #include "route/route.h"
 #include "arp/arp.h"
 
@@ -122,7 +123,8 @@ static const uint8_t g_multicast_ethaddr[3] =
  *   packet in the d_buf is replaced by an ARP request packet for the
  *   IP address. The IP packet is dropped and it is assumed that the
  *   higher level protocols (e.g., TCP) eventually will retransmit the
- *   dropped packet.
+ *   dropped packet, unless CONFIG_NETDEV_RESOLVE_QUEUE keeps a copy to
+ *   send when the ARP reply arrives.
  *
  *   Upon return in either the case, a packet to be sent is present in the
  *   d_buf buffer and the d_len field holds the length of the Ethernet
@@ -267,6 +269,12 @@ void arp_out(FAR struct net_driver_s *dev)
     {
       ninfo("ARP request for IP %08lx\n", (unsigned long)ipaddr);
 
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+      /* Keep the IP packet to send it when the reply arrives */
+
+      netdev_resolve_hold(dev, &ipaddr, sizeof(in_addr_t));
+#endif
+
       /* The destination address was not in our ARP table, so we overwrite
        * the IP packet with an ARP request.
        */
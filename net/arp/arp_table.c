@@ -48,6 +48,7 @@
 #ifdef CONFIG_NET
 
 #include <sys/ioctl.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <debug.h>
@@ -91,6 +92,12 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+#ifdef CONFIG_NET_ARPTAB_HASH
+/* The in-use entries of g_arptable indexed by IP address */
+
+static FAR struct arp_entry_s *g_arphash[CONFIG_NET_ARPTAB_HASHSIZE];
+#endif
+
 static const struct ether_addr g_zero_ethaddr =
 {
   {
@@ -148,17 +155,148 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
   return 1;
 }
 
+#ifdef CONFIG_NET_ARPTAB_HASH
+
+/****************************************************************************
+ * Name: arp_hashkey
+ *
+ * Description:
+ *   Return the hash bucket of an IPv4 address.
+ *
+ ****************************************************************************/
+
+static inline unsigned int arp_hashkey(in_addr_t ipaddr)
+{
+  uint32_t hash = (uint32_t)ipaddr;
+
+  /* Mix the bits so that hosts on the same subnet spread out */
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash % CONFIG_NET_ARPTAB_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: arp_hashadd
+ *
+ * Description:
+ *   Link an ARP table entry whose IP address has been set into its hash
+ *   bucket.
+ *
+ ****************************************************************************/
+
+static void arp_hashadd(FAR struct arp_entry_s *tabptr)
+{
+  FAR struct arp_entry_s **head = &g_arphash[arp_hashkey(tabptr->at_ipaddr)];
+
+  tabptr->at_hnext = *head;
+  *head            = tabptr;
+}
+
+/****************************************************************************
+ * Name: arp_hashdel
+ *
+ * Description:
+ *   Unlink an ARP table entry from its hash bucket.  This must be done
+ *   before the IP address of the entry is changed.
+ *
+ ****************************************************************************/
+
+static void arp_hashdel(FAR struct arp_entry_s *tabptr)
+{
+  FAR struct arp_entry_s **pptr = &g_arphash[arp_hashkey(tabptr->at_ipaddr)];
+
+  while (*pptr != NULL)
+    {
+      if (*pptr == tabptr)
+        {
+          *pptr = tabptr->at_hnext;
+          break;
+        }
+
+      pptr = &(*pptr)->at_hnext;
+    }
+
+  tabptr->at_hnext = NULL;
+}
+
+#else
+#  define arp_hashadd(tabptr)
+#  define arp_hashdel(tabptr)
+#endif /* CONFIG_NET_ARPTAB_HASH */
+
+/****************************************************************************
+ * Name: arp_findentry
+ *
+ * Description:
+ *   Find the in-use ARP entry for this IP address and device, whether it
+ *   has expired or not.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *   dev    - Device structure
+ *
+ * Assumptions:
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_findentry(in_addr_t ipaddr,
+                                             FAR struct net_driver_s *dev)
+{
+  FAR struct arp_entry_s *tabptr;
+#ifdef CONFIG_NET_ARPTAB_HASH
+
+  /* Only the entries in the IP address' bucket can match */
+
+  for (tabptr = g_arphash[arp_hashkey(ipaddr)]; tabptr != NULL;
+       tabptr = tabptr->at_hnext)
+    {
+      if (tabptr->at_dev == dev &&
+          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+#else
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+    {
+      tabptr = &g_arptable[i];
+      if (tabptr->at_dev == dev &&
+          tabptr->at_ipaddr != 0 &&
+          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+#endif
+
+  /* Not found */
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: arp_return_old_entry
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Compare and return the ARP table entry that should be replaced first:
+ *   An unused entry, then an expired entry, then the least recently used
+ *   entry.
  *
  ****************************************************************************/
 
 static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2,
+                     clock_t now)
 {
+  bool expired1;
+  bool expired2;
+
   if (e1->at_ipaddr == 0)
     {
       return e1;
@@ -167,7 +305,15 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
     {
       return e2;
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  expired1 = now - e1->at_time > ARP_MAXAGE_TICK;
+  expired2 = now - e2->at_time > ARP_MAXAGE_TICK;
+
+  if (expired1 != expired2)
+    {
+      return expired1 ? e1 : e2;
+    }
+  else if ((int)(e1->at_used - e2->at_used) <= 0)
     {
       return e1;
     }
@@ -197,19 +343,14 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
                                           FAR struct net_driver_s *dev)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_findentry(ipaddr, dev);
+  if (tabptr != NULL &&
+      clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_dev == dev &&
-          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      return tabptr;
     }
 
   /* Not found */
@@ -275,42 +416,29 @@ static void arp_get_arpreq(FAR struct arpreq *output,
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR const uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
-  bool found = false;
   bool new_entry;
 #endif
+  clock_t now = clock_systime_ticks();
+  bool found;
   int i;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update.  If none is found, the IP -> MAC
+   * address mapping is inserted in the ARP table in place of the entry
+   * that is least worth keeping.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
-    {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
+  tabptr = arp_findentry(ipaddr, dev);
+  found  = tabptr != NULL;
 
-      if (g_arptable[i].at_dev == dev &&
-          g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-#ifdef CONFIG_NETLINK_ROUTE
-          found = true;
-#endif
-          break;
-        }
-      else
+  if (!found)
+    {
+      tabptr = &g_arptable[0];
+      for (i = 1; i < CONFIG_NET_ARPTAB_SIZE && tabptr->at_ipaddr != 0; ++i)
         {
-          /* Record the oldest entry. */
-
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
+          tabptr = arp_return_old_entry(tabptr, &g_arptable[i], now);
         }
     }
 
@@ -318,6 +446,14 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
     {
       ethaddr = g_zero_ethaddr.ether_addr_octet;
     }
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+  else
+    {
+      /* Release the packets that were waiting for this address */
+
+      netdev_resolve_done(dev, &ipaddr, sizeof(in_addr_t));
+    }
+#endif
 
   /* When overwite old entry, notify old entry RTM_DELNEIGH */
 
@@ -338,10 +474,21 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
+  if (!found)
+    {
+      if (tabptr->at_ipaddr != 0)
+        {
+          arp_hashdel(tabptr);
+        }
+
+      tabptr->at_ipaddr = ipaddr;
+      arp_hashadd(tabptr);
+    }
+
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
-  tabptr->at_time = clock_systime_ticks();
+  tabptr->at_dev  = dev;
+  tabptr->at_time = now;
+  tabptr->at_used = now;
 
   /* Notify the new entry */
 
@@ -437,6 +584,10 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
           memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
         }
 
+      /* Keep the entry from being replaced while it is in use */
+
+      tabptr->at_used = clock_systime_ticks();
+
       /* Return success meaning that a valid Ethernet MAC address mapping
        * is available for the IP address.
        */
@@ -497,6 +648,7 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 
       /* Yes.. Set the IP address to zero to "delete" it */
 
+      arp_hashdel(tabptr);
       tabptr->at_ipaddr = 0;
       return OK;
     }
@@ -526,6 +678,11 @@ void arp_cleanup(FAR struct net_driver_s *dev)
     {
       if (dev == g_arptable[i].at_dev)
         {
+          if (g_arptable[i].at_ipaddr != 0)
+            {
+              arp_hashdel(&g_arptable[i]);
+            }
+
           memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
         }
     }
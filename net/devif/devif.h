@@ -500,6 +500,43 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
                     unsigned int target_offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_xip_send
+ *
+ * Description:
+ *   Like devif_file_send(), but the file data is directly addressable and
+ *   is linked into the packet instead of being copied.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+int devif_xip_send(FAR struct net_driver_s *dev, FAR const void *buf,
+                   unsigned int len, unsigned int target_offset);
+#endif
+
+/****************************************************************************
+ * Name: devif_xip_unshare
+ *
+ * Description:
+ *   Replace a packet in dev->d_iob that references file data in place
+ *   (devif_xip_send()) by a private copy, so that the input path may
+ *   modify it.
+ *
+ * Returned Value:
+ *   OK on success, -ENOMEM if the copy could not be allocated.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+int devif_xip_unshare(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: devif_out
  *
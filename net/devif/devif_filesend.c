@@ -37,6 +37,24 @@
 
 #ifdef CONFIG_MM_IOB
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+/****************************************************************************
+ * Name: devif_xip_free
+ *
+ * Description:
+ *   The borrowed file data is owned by the file system, nothing to free.
+ *
+ ****************************************************************************/
+
+static void devif_xip_free(FAR void *data)
+{
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -146,7 +164,8 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
 
   iob_update_pktlen(dev->d_iob, target_offset + len, false);
 
-  dev->d_sndlen = len;
+  dev->d_sndlen    = len;
+  dev->d_sndsumlen = 0;
   return len;
 
 errout:
@@ -163,4 +182,130 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+/****************************************************************************
+ * Name: devif_xip_send
+ *
+ * Description:
+ *   Like devif_file_send(), but the file data is directly addressable
+ *   (e.g. an XIP ROMFS image or a tmpfs buffer).  Instead of copying the
+ *   data, an iob that points at it is linked after the protocol headers.
+ *
+ *   The data must stay valid and unchanged until the device has sent the
+ *   packet, and it is read-only: a packet that loops back to the input
+ *   path has to be copied first by devif_xip_unshare().
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_xip_send(FAR struct net_driver_s *dev, FAR const void *buf,
+                   unsigned int len, unsigned int target_offset)
+{
+  FAR struct iob_s *tail;
+  FAR struct iob_s *iob;
+  int ret;
+
+  if (dev == NULL)
+    {
+      ret = -ENODEV;
+      goto errout;
+    }
+
+  if (len == 0 || len > UINT16_MAX)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+#ifndef CONFIG_NET_IPFRAG
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+    {
+      ret = -EMSGSIZE;
+      goto errout;
+    }
+#endif
+
+  if (netdev_iob_prepare(dev, false, 0) != OK)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  iob = iob_alloc_with_data((FAR void *)buf, len, devif_xip_free);
+  if (iob == NULL)
+    {
+      netdev_iob_release(dev);
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  iob->io_len = len;
+
+  /* Keep only the headers in the device buffer and chain the data behind
+   * them.
+   */
+
+  iob_update_pktlen(dev->d_iob, target_offset, false);
+
+  tail = dev->d_iob;
+  while (tail->io_flink != NULL)
+    {
+      tail = tail->io_flink;
+    }
+
+  tail->io_flink         = iob;
+  dev->d_iob->io_pktlen += len;
+
+  dev->d_sndlen    = len;
+  dev->d_sndsumlen = 0;
+  return len;
+
+errout:
+  nerr("ERROR: devif_xip_send error: %d\n", ret);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: devif_xip_unshare
+ *
+ * Description:
+ *   Replace a packet in dev->d_iob that references file data in place by a
+ *   private copy.  The input path appends the IOBs to read-ahead queues
+ *   and packs them (iob_pack()), which would write into the file data.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_xip_unshare(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob;
+
+  for (iob = dev->d_iob; iob != NULL; iob = iob->io_flink)
+    {
+      if (iob->io_free == devif_xip_free)
+        {
+          break;
+        }
+    }
+
+  if (iob == NULL)
+    {
+      return OK;
+    }
+
+  iob = netdev_iob_clone(dev, false);
+  if (iob == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  netdev_iob_replace(dev, iob);
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_MM_IOB */
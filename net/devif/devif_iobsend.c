@@ -59,6 +59,7 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                    unsigned int len, unsigned int offset,
                    unsigned int target_offset)
 {
+  struct chksum_copy_s state;
   int ret;
 
   if (dev == NULL)
@@ -74,7 +75,11 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
     }
 
 #ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset
+#  ifdef CONFIG_NET_TCP_GSO
+      && len + target_offset + NET_LL_HDRLEN(dev) > dev->d_gsosize
+#  endif
+     )
     {
       ret = -EMSGSIZE;
       goto errout;
@@ -89,17 +94,25 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
       goto errout;
     }
 
-  /* Clone the iob to target device buffer */
+  /* Clone the iob to target device buffer, summing the payload on the
+   * way so that the transport checksum need not read it again.
+   */
 
-  ret = iob_clone_partial(iob, len, offset, dev->d_iob,
-                          target_offset, false, false);
+  state.sum = 0;
+  state.odd = false;
+
+  ret = iob_clone_partial_fn(iob, len, offset, dev->d_iob,
+                             target_offset, false, false,
+                             chksum_copy, &state);
   if (ret != OK)
     {
       netdev_iob_release(dev);
       goto errout;
     }
 
-  dev->d_sndlen = len;
+  dev->d_sndlen    = len;
+  dev->d_sndsum    = state.sum;
+  dev->d_sndsumlen = len;
 
 #ifdef CONFIG_NET_TCP_WRBUFFER_DUMP
   /* Dump the outgoing device buffer */
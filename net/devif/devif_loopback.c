@@ -33,6 +33,8 @@
 #include <nuttx/net/pkt.h>
 #include <nuttx/net/netdev.h>
 
+#include "devif/devif.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -96,6 +98,18 @@ int devif_loopback(FAR struct net_driver_s *dev)
       return 0;
     }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* The payload may still be the file data that sendfile() sent in place */
+
+  if (devif_xip_unshare(dev) < 0)
+    {
+      nwarn("WARNING: Dropping looped back packet, no IOB for a copy\n");
+      NETDEV_TXERRORS(dev);
+      dev->d_len = 0;
+      return 1;
+    }
+#endif
+
   /* Loop while if there is data "sent" to ourself.
    * Sending, of course, just means relaying back through the network.
    */
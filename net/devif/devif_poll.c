@@ -794,6 +794,15 @@ static int devif_poll_connections(FAR struct net_driver_s *dev,
 
   if (!bstop)
 #endif
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+    {
+      /* Send the packets that were waiting for address resolution */
+
+      bstop = netdev_resolve_poll(dev, callback);
+    }
+
+  if (!bstop)
+#endif
 #ifdef CONFIG_NET_PKT
     {
       /* Check for pending packet socket transfer */
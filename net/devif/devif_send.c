@@ -71,6 +71,7 @@
 int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
                int len, int offset)
 {
+  struct chksum_copy_s state;
   int ret;
 
   if (dev == NULL)
@@ -106,14 +107,22 @@ int devif_send(FAR struct net_driver_s *dev, FAR const void *buf,
 
   iob_update_pktlen(dev->d_iob, offset < 0 ? 0 : offset, false);
 
-  ret = iob_trycopyin(dev->d_iob, buf, len, offset, false);
+  /* Copy the payload, summing it on the way for the transport checksum */
+
+  state.sum = 0;
+  state.odd = false;
+
+  ret = iob_copyin_fn(dev->d_iob, buf, len, offset, false, false,
+                      chksum_copy, &state);
   if (ret != len)
     {
       netdev_iob_release(dev);
       goto errout;
     }
 
-  dev->d_sndlen = len;
+  dev->d_sndlen    = len;
+  dev->d_sndsum    = state.sum;
+  dev->d_sndsumlen = len;
 
   return dev->d_sndlen;
 
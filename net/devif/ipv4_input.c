@@ -153,6 +153,10 @@ static int ipv4_in(FAR struct net_driver_s *dev)
   uint16_t totlen;
   int ret = OK;
 
+  /* Any payload checksum left from the last transmission is stale */
+
+  dev->d_sndsumlen = 0;
+
   /* Handle ARP on input then give the IPv4 packet to the network layer */
 
   arp_ipin(dev);
@@ -199,6 +199,10 @@ static int ipv6_in(FAR struct net_driver_s *dev)
   bool isfrag = false;
 #endif
 
+  /* Any payload checksum left from the last transmission is stale */
+
+  dev->d_sndsumlen = 0;
+
   /* This is where the input processing starts. */
 
 #ifdef CONFIG_NET_STATISTICS
@@ -354,7 +354,7 @@ static sockcaps_t inet_sockcaps(FAR struct socket *psock)
 
 #ifdef NET_UDP_HAVE_STACK
       case SOCK_DGRAM:
-        return SOCKCAP_NONBLOCKING;
+        return SOCKCAP_NONBLOCKING | SOCKCAP_NETBATCH;
 #endif
 
 #if defined(NET_TCP_HAVE_STACK) || defined(NET_UDP_HAVE_STACK)
@@ -1269,6 +1269,19 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv4(dev->d_flags))
     {
+#ifdef CONFIG_NET_TCP_GSO
+      /* Oversized TCP packets that TCP built for segmentation offload are
+       * segmented by the driver instead.  Others, such as forwarded
+       * packets, are fragmented as usual.
+       */
+
+      if (dev->d_gsomss != 0 && IPv4BUF->proto == IP_PROTO_TCP &&
+          dev->d_iob->io_pktlen + NET_LL_HDRLEN(dev) <= dev->d_gsosize)
+        {
+          return OK;
+        }
+#endif
+
       return ipv4_fragout(dev, mtu);
     }
 #endif
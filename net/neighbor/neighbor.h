@@ -48,12 +48,64 @@
 
 extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+/* The in-use entries of g_neighbors indexed by IPv6 address.  The hash
+ * chain link of g_neighbors[i] is g_neighbor_hnext[i]; it is kept outside
+ * of struct neighbor_entry_s because that structure is copied out to user
+ * space by neighbor_snapshot().
+ */
+
+extern FAR struct neighbor_entry_s *
+g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+extern FAR struct neighbor_entry_s *
+g_neighbor_hnext[CONFIG_NET_IPv6_NCONF_ENTRIES];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_hashkey
+ *
+ * Description:
+ *   Return the hash bucket of an IPv6 address.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+static inline unsigned int neighbor_hashkey(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash = ((uint32_t)(ipaddr[0] ^ ipaddr[2] ^
+                              ipaddr[4] ^ ipaddr[6]) << 16) |
+                  (ipaddr[1] ^ ipaddr[3] ^ ipaddr[5] ^ ipaddr[7]);
+
+  /* Mix the bits so that neighbors on the same prefix spread out */
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash % CONFIG_NET_IPv6_NCONF_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: neighbor_hashnext
+ *
+ * Description:
+ *   Return the next entry in the hash bucket of a Neighbor Table entry.
+ *
+ ****************************************************************************/
+
+static inline FAR struct neighbor_entry_s **
+neighbor_hashnext(FAR struct neighbor_entry_s *neighbor)
+{
+  return &g_neighbor_hnext[neighbor - g_neighbors];
+}
+#endif
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
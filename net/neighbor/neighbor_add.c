@@ -41,6 +41,60 @@
 #include "netlink/netlink.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+
+/****************************************************************************
+ * Name: neighbor_hashadd
+ *
+ * Description:
+ *   Link a Neighbor Table entry whose IPv6 address has been set into its
+ *   hash bucket.
+ *
+ ****************************************************************************/
+
+static void neighbor_hashadd(FAR struct neighbor_entry_s *neighbor)
+{
+  FAR struct neighbor_entry_s **head =
+    &g_neighbor_hash[neighbor_hashkey(neighbor->ne_ipaddr)];
+
+  *neighbor_hashnext(neighbor) = *head;
+  *head = neighbor;
+}
+
+/****************************************************************************
+ * Name: neighbor_hashdel
+ *
+ * Description:
+ *   Unlink a Neighbor Table entry from its hash bucket.  This must be done
+ *   before the IPv6 address of the entry is changed.
+ *
+ ****************************************************************************/
+
+static void neighbor_hashdel(FAR struct neighbor_entry_s *neighbor)
+{
+  FAR struct neighbor_entry_s **pptr =
+    &g_neighbor_hash[neighbor_hashkey(neighbor->ne_ipaddr)];
+
+  while (*pptr != NULL)
+    {
+      if (*pptr == neighbor)
+        {
+          *pptr = *neighbor_hashnext(neighbor);
+          break;
+        }
+
+      pptr = neighbor_hashnext(*pptr);
+    }
+
+  *neighbor_hashnext(neighbor) = NULL;
+}
+
+#endif /* CONFIG_NET_IPv6_NCONF_HASH */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -118,10 +172,24 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
    * "oldest_ndx" variable).
    */
 
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+  if (!found && g_neighbors[oldest_ndx].ne_time != 0)
+    {
+      neighbor_hashdel(&g_neighbors[oldest_ndx]);
+    }
+#endif
+
   g_neighbors[oldest_ndx].ne_dev  = dev;
   g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
   net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
 
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+  if (!found)
+    {
+      neighbor_hashadd(&g_neighbors[oldest_ndx]);
+    }
+#endif
+
   g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
   g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
 
@@ -139,4 +207,10 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
   /* Dump the contents of the new entry */
 
   neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+  /* Release the packets that were waiting for this address */
+
+  netdev_resolve_done(dev, ipaddr, sizeof(net_ipv6addr_t));
+#endif
 }
@@ -36,6 +36,7 @@
 #include <nuttx/net/neighbor.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "route/route.h"
 #include "icmpv6/icmpv6.h"
 #include "neighbor/neighbor.h"
@@ -164,6 +165,14 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NET_ICMPv6
            ninfo("IPv6 Neighbor solicitation for IPv6\n");
 
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+          /* Keep the IPv6 packet to send it when the advertisement
+           * arrives.
+           */
+
+          netdev_resolve_hold(dev, ipaddr, sizeof(net_ipv6addr_t));
+#endif
+
           /* The destination address was not in our Neighbor Table, so we
            * overwrite the IPv6 packet with an ICMPv6 Neighbor Solicitation
            * message.
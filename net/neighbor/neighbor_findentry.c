@@ -53,6 +53,22 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+  FAR struct neighbor_entry_s *neighbor;
+
+  /* Only the entries in the IPv6 address' bucket can match */
+
+  for (neighbor = g_neighbor_hash[neighbor_hashkey(ipaddr)];
+       neighbor != NULL;
+       neighbor = *neighbor_hashnext(neighbor))
+    {
+      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
+        {
+          neighbor_dumpentry("Entry found", neighbor);
+          return neighbor;
+        }
+    }
+#else
   int i;
 
   for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
@@ -65,6 +81,7 @@ FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
           return neighbor;
         }
     }
+#endif
 
   neighbor_dumpipaddr("Not found", ipaddr);
   return NULL;
@@ -38,6 +38,13 @@
 
 struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+#ifdef CONFIG_NET_IPv6_NCONF_HASH
+/* The in-use entries of g_neighbors indexed by IPv6 address */
+
+FAR struct neighbor_entry_s *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+FAR struct neighbor_entry_s *g_neighbor_hnext[CONFIG_NET_IPv6_NCONF_ENTRIES];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
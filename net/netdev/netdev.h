@@ -533,6 +533,35 @@ void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
                            FAR const void *dst_addr, uint16_t dst_port);
 #endif
 
+/****************************************************************************
+ * Name: netdev_resolve_hold, netdev_resolve_done, netdev_resolve_poll and
+ *       netdev_resolve_drop
+ *
+ * Description:
+ *   Hold IP packets whose next hop is being resolved by ARP or Neighbor
+ *   Discovery, and send them once the link layer address is learned:
+ *
+ *   netdev_resolve_hold - Keep a copy of the IP packet in dev->d_iob,
+ *     waiting for 'addr' (4 bytes for IPv4, 16 for IPv6)
+ *   netdev_resolve_done - The link layer address of 'addr' is now known
+ *   netdev_resolve_poll - Send the ready packets from devif_poll()
+ *   netdev_resolve_drop - Drop everything held for 'dev'
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+void netdev_resolve_hold(FAR struct net_driver_s *dev,
+                         FAR const void *addr, size_t addrlen);
+void netdev_resolve_done(FAR struct net_driver_s *dev,
+                         FAR const void *addr, size_t addrlen);
+int netdev_resolve_poll(FAR struct net_driver_s *dev,
+                        devif_poll_callback_t callback);
+void netdev_resolve_drop(FAR struct net_driver_s *dev);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -96,5 +96,8 @@ void netdev_carrier_off(FAR struct net_driver_s *dev)
 
       devif_dev_event(dev, NETDEV_DOWN);
       arp_cleanup(dev);
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+      netdev_resolve_drop(dev);
+#endif
     }
 }
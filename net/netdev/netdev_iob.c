@@ -83,6 +83,12 @@ int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled,
 
   dev->d_buf = NETLLBUF;
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* Only TCP sets the segment size, for the packet it is about to build */
+
+  dev->d_gsomss = 0;
+#endif
+
   return OK;
 }
 
@@ -146,6 +152,12 @@ void netdev_iob_replace(FAR struct net_driver_s *dev, FAR struct iob_s *iob)
   dev->d_iob = iob;
   dev->d_buf = NETLLBUF;
   dev->d_len = iob->io_pktlen;
+
+#ifdef CONFIG_NET_TCP_GSO
+  /* The new packet was not built by TCP for segmentation offload */
+
+  dev->d_gsomss = 0;
+#endif
 }
 
 /****************************************************************************
@@ -164,9 +176,10 @@ void netdev_iob_clear(FAR struct net_driver_s *dev)
 {
   /* Clear the device buffer */
 
-  dev->d_iob = NULL;
-  dev->d_buf = NULL;
-  dev->d_len = 0;
+  dev->d_iob       = NULL;
+  dev->d_buf       = NULL;
+  dev->d_len       = 0;
+  dev->d_sndsumlen = 0;
 }
 
 /****************************************************************************
@@ -190,7 +203,8 @@ void netdev_iob_release(FAR struct net_driver_s *dev)
       dev->d_iob = NULL;
     }
 
-  dev->d_buf = NULL;
+  dev->d_buf       = NULL;
+  dev->d_sndsumlen = 0;
 }
 
 /****************************************************************************
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * net/netdev/netdev_resolve.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "devif/devif.h"
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RESOLVE_TIMEOUT MSEC2TICK(CONFIG_NETDEV_RESOLVE_QUEUE_TIMEOUT)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One IP packet waiting for the link layer address of its next hop */
+
+struct netdev_resolve_s
+{
+  FAR struct iob_s *rq_iob;         /* The IP packet, NULL if unused */
+  FAR struct net_driver_s *rq_dev;  /* The device to send it on */
+  clock_t rq_time;                  /* When it was held */
+#ifdef CONFIG_NET_TCP_GSO
+  uint16_t rq_gsomss;               /* Segment size of a TCP GSO packet */
+#endif
+  bool rq_done;                     /* The next hop has been resolved */
+  uint8_t rq_addrlen;               /* 4 (ARP) or 16 (Neighbor Discovery) */
+  uint8_t rq_addr[16];              /* Next hop IP address */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct netdev_resolve_s
+  g_netdev_resolve[CONFIG_NETDEV_RESOLVE_QUEUE_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_resolve_free
+ *
+ * Description:
+ *   Drop the packet held in an entry.
+ *
+ ****************************************************************************/
+
+static void netdev_resolve_free(FAR struct netdev_resolve_s *rq)
+{
+  iob_free_chain(rq->rq_iob);
+  rq->rq_iob = NULL;
+  rq->rq_dev = NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_resolve_hold
+ *
+ * Description:
+ *   Keep a copy of the IP packet in dev->d_iob until the link layer address
+ *   of 'addr' is known, instead of losing it when the packet is replaced
+ *   by an ARP request or a Neighbor Solicitation.  If the queue is full,
+ *   the packet held the longest is dropped.
+ *
+ * Input Parameters:
+ *   dev     - The device the packet is being sent on
+ *   addr    - The next hop IPv4 or IPv6 address, in network order
+ *   addrlen - The size of 'addr', 4 or 16
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_resolve_hold(FAR struct net_driver_s *dev,
+                         FAR const void *addr, size_t addrlen)
+{
+  FAR struct netdev_resolve_s *oldest = NULL;
+  FAR struct netdev_resolve_s *rq = NULL;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  DEBUGASSERT(addrlen <= sizeof(rq->rq_addr));
+
+  for (i = 0; i < CONFIG_NETDEV_RESOLVE_QUEUE_SIZE; i++)
+    {
+      FAR struct netdev_resolve_s *tmp = &g_netdev_resolve[i];
+
+      if (tmp->rq_iob != NULL && !tmp->rq_done &&
+          now - tmp->rq_time >= RESOLVE_TIMEOUT)
+        {
+          /* The address was never resolved */
+
+          NETDEV_TXERRORS(tmp->rq_dev);
+          netdev_resolve_free(tmp);
+        }
+
+      if (tmp->rq_iob == NULL)
+        {
+          rq = tmp;
+          break;
+        }
+
+      if (oldest == NULL ||
+          (sclock_t)(tmp->rq_time - oldest->rq_time) < 0)
+        {
+          oldest = tmp;
+        }
+    }
+
+  if (rq == NULL)
+    {
+      ninfo("Resolve queue full, dropping the oldest packet\n");
+      NETDEV_TXERRORS(oldest->rq_dev);
+      netdev_resolve_free(oldest);
+      rq = oldest;
+    }
+
+  rq->rq_iob = netdev_iob_clone(dev, true);
+  if (rq->rq_iob == NULL)
+    {
+      return;
+    }
+
+  rq->rq_dev     = dev;
+  rq->rq_time    = now;
+  rq->rq_done    = false;
+  rq->rq_addrlen = addrlen;
+  memcpy(rq->rq_addr, addr, addrlen);
+#ifdef CONFIG_NET_TCP_GSO
+  rq->rq_gsomss  = dev->d_gsomss;
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_resolve_done
+ *
+ * Description:
+ *   The link layer address of 'addr' was learned on 'dev'.  Mark the
+ *   packets held for it as ready and ask the driver to poll, so that
+ *   netdev_resolve_poll() sends them.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_resolve_done(FAR struct net_driver_s *dev,
+                         FAR const void *addr, size_t addrlen)
+{
+  bool notify = false;
+  int i;
+
+  for (i = 0; i < CONFIG_NETDEV_RESOLVE_QUEUE_SIZE; i++)
+    {
+      FAR struct netdev_resolve_s *rq = &g_netdev_resolve[i];
+
+      if (rq->rq_iob != NULL && rq->rq_dev == dev && !rq->rq_done &&
+          rq->rq_addrlen == addrlen &&
+          memcmp(rq->rq_addr, addr, addrlen) == 0)
+        {
+          rq->rq_done = true;
+          notify      = true;
+        }
+    }
+
+  if (notify)
+    {
+      netdev_txnotify_dev(dev);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_resolve_poll
+ *
+ * Description:
+ *   Send the packets on 'dev' whose next hop has been resolved.  The link
+ *   layer header is built again by devif_poll_out(), from the table entry
+ *   that has just been added.
+ *
+ * Returned Value:
+ *   Zero if the polling may continue, else non-zero.
+ *
+ * Assumptions:
+ *   Called from devif_poll() with the network locked.
+ *
+ ****************************************************************************/
+
+int netdev_resolve_poll(FAR struct net_driver_s *dev,
+                        devif_poll_callback_t callback)
+{
+  FAR struct iob_s *iob;
+  bool reused = false;
+  int bstop = false;
+  int i;
+
+  for (i = 0; i < CONFIG_NETDEV_RESOLVE_QUEUE_SIZE && !bstop; i++)
+    {
+      FAR struct netdev_resolve_s *rq = &g_netdev_resolve[i];
+
+      if (rq->rq_iob == NULL || rq->rq_dev != dev || !rq->rq_done)
+        {
+          continue;
+        }
+
+      iob        = rq->rq_iob;
+      rq->rq_iob = NULL;
+      rq->rq_dev = NULL;
+      reused     = true;
+
+      netdev_iob_replace(dev, iob);
+#ifdef CONFIG_NET_TCP_GSO
+      dev->d_gsomss = rq->rq_gsomss;
+#endif
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (rq->rq_addrlen == sizeof(in_addr_t))
+        {
+          IFF_SET_IPv4(dev->d_flags);
+        }
+      else
+        {
+          IFF_SET_IPv6(dev->d_flags);
+        }
+#endif
+
+      bstop = devif_poll_out(dev, callback);
+    }
+
+  /* Leave a buffer for the rest of the poll, as devif_poll_ipfrag() does */
+
+  if (!bstop && reused)
+    {
+      iob_update_pktlen(dev->d_iob, 0, false);
+      netdev_iob_prepare(dev, true, 0);
+    }
+
+  return bstop;
+}
+
+/****************************************************************************
+ * Name: netdev_resolve_drop
+ *
+ * Description:
+ *   Drop all packets held for 'dev', e.g. when it goes down.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_resolve_drop(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NETDEV_RESOLVE_QUEUE_SIZE; i++)
+    {
+      if (g_netdev_resolve[i].rq_iob != NULL &&
+          g_netdev_resolve[i].rq_dev == dev)
+        {
+          netdev_resolve_free(&g_netdev_resolve[i]);
+        }
+    }
+}
+
+#endif /* CONFIG_NETDEV_RESOLVE_QUEUE */
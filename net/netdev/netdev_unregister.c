@@ -149,6 +149,9 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
+#endif
+#ifdef CONFIG_NETDEV_RESOLVE_QUEUE
+      netdev_resolve_drop(dev);
 #endif
       net_unlock();
 
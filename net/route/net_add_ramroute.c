@@ -63,6 +63,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -84,6 +87,18 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  /* Index the new entry for longest prefix match */
+
+  ret = ramroute_ipv4_trie_add((FAR struct net_route_ipv4_entry_s *)route);
+  if (ret < 0)
+    {
+      net_unlock();
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
@@ -100,6 +115,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -121,6 +139,18 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  /* Index the new entry for longest prefix match */
+
+  ret = ramroute_ipv6_trie_add((FAR struct net_route_ipv6_entry_s *)route);
+  if (ret < 0)
+    {
+      net_unlock();
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
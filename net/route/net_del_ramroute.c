@@ -113,6 +113,10 @@ static int net_del_ipv4route(FAR struct net_route_ipv4_s *route,
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+      ramroute_ipv4_trie_del((FAR struct net_route_ipv4_entry_s *)route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET);
 
       /* And free the routing table entry by adding it to the free list */
@@ -171,6 +175,10 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+      ramroute_ipv6_trie_del((FAR struct net_route_ipv6_entry_s *)route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET6);
 
       /* And free the routing table entry by adding it to the free list */
@@ -0,0 +1,724 @@
+/****************************************************************************
+ * net/route/net_trie_ramroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+
+#include "route/ramroute.h"
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the key in a trie node.  IPv4 keys use only the first four
+ * bytes.
+ */
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#  define TRIE_KEYSIZE 16
+#else
+#  define TRIE_KEYSIZE 4
+#endif
+
+/* A path-compressed trie never needs more than one branch (glue) node
+ * per prefix, so twice the number of routes is always enough.
+ */
+
+#define TRIE_IPv4_NNODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#define TRIE_IPv6_NNODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of a path-compressed binary trie.  A node covers the prefix
+ * made of the first 'plen' bits of 'key'; the remaining bits of 'key' are
+ * zero.  Nodes without a route only exist to branch.
+ */
+
+struct trie_node_s
+{
+  FAR struct trie_node_s *child[2];
+  FAR void               *route;  /* First route with this prefix or NULL */
+  uint8_t                 plen;
+  uint8_t                 key[TRIE_KEYSIZE];
+};
+
+struct trie_s
+{
+  FAR struct trie_node_s *root;
+  FAR struct trie_node_s *free;   /* Unused nodes, linked by child[0] */
+};
+
+typedef CODE int (*trie_visit_t)(FAR void *route, FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static struct trie_s g_ipv4_trie;
+static struct trie_node_s g_ipv4_trie_nodes[TRIE_IPv4_NNODES];
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static struct trie_s g_ipv6_trie;
+static struct trie_node_s g_ipv6_trie_nodes[TRIE_IPv6_NNODES];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: trie_bit
+ *
+ * Description:
+ *   Return bit 'n' of 'key', counting from the most significant bit of the
+ *   first byte (i.e. network order).
+ *
+ ****************************************************************************/
+
+static inline int trie_bit(FAR const uint8_t *key, unsigned int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: trie_common
+ *
+ * Description:
+ *   Return the number of leading bits, at most 'limit', in which 'a' and
+ *   'b' agree.
+ *
+ ****************************************************************************/
+
+static unsigned int trie_common(FAR const uint8_t *a,
+                                FAR const uint8_t *b,
+                                unsigned int limit)
+{
+  unsigned int n = 0;
+  uint8_t diff;
+
+  while (n < limit)
+    {
+      diff = a[n >> 3] ^ b[n >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              n++;
+            }
+
+          break;
+        }
+
+      n += 8;
+    }
+
+  return MIN(n, limit);
+}
+
+/****************************************************************************
+ * Name: trie_masklen
+ *
+ * Description:
+ *   Return the prefix length of a netmask, or -EINVAL if the mask is not
+ *   contiguous.
+ *
+ ****************************************************************************/
+
+static int trie_masklen(FAR const uint8_t *mask, unsigned int nbits)
+{
+  unsigned int plen = 0;
+  unsigned int n;
+
+  while (plen < nbits && trie_bit(mask, plen))
+    {
+      plen++;
+    }
+
+  for (n = plen; n < nbits; n++)
+    {
+      if (trie_bit(mask, n))
+        {
+          return -EINVAL;
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: trie_init
+ ****************************************************************************/
+
+static void trie_init(FAR struct trie_s *trie,
+                      FAR struct trie_node_s *nodes, unsigned int nnodes)
+{
+  trie->root = NULL;
+  trie->free = NULL;
+
+  while (nnodes-- > 0)
+    {
+      nodes[nnodes].child[0] = trie->free;
+      trie->free = &nodes[nnodes];
+    }
+}
+
+/****************************************************************************
+ * Name: trie_alloc
+ ****************************************************************************/
+
+static FAR struct trie_node_s *trie_alloc(FAR struct trie_s *trie,
+                                          FAR const uint8_t *key,
+                                          unsigned int plen,
+                                          FAR void *route)
+{
+  FAR struct trie_node_s *node = trie->free;
+
+  if (node != NULL)
+    {
+      trie->free = node->child[0];
+      memset(node, 0, sizeof(*node));
+      memcpy(node->key, key, (plen + 7) >> 3);
+      if ((plen & 7) != 0)
+        {
+          node->key[plen >> 3] &= 0xff << (8 - (plen & 7));
+        }
+
+      node->plen  = plen;
+      node->route = route;
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: trie_free
+ ****************************************************************************/
+
+static void trie_free(FAR struct trie_s *trie, FAR struct trie_node_s *node)
+{
+  node->child[0] = trie->free;
+  trie->free     = node;
+}
+
+/****************************************************************************
+ * Name: trie_insert
+ *
+ * Description:
+ *   Enter 'route' as the route for the prefix key/plen.  -EEXIST is
+ *   returned (with *prev set to the existing route) if the prefix already
+ *   has a route.
+ *
+ ****************************************************************************/
+
+static int trie_insert(FAR struct trie_s *trie, FAR const uint8_t *key,
+                       unsigned int plen, FAR void *route,
+                       FAR void **prev)
+{
+  FAR struct trie_node_s **pp = &trie->root;
+  FAR struct trie_node_s *node;
+  FAR struct trie_node_s *glue;
+  FAR struct trie_node_s *leaf;
+  unsigned int common;
+
+  while ((node = *pp) != NULL)
+    {
+      common = trie_common(node->key, key, MIN(node->plen, plen));
+      if (common < node->plen)
+        {
+          /* The new prefix leaves the path somewhere inside this node's
+           * prefix.
+           */
+
+          leaf = trie_alloc(trie, key, plen, route);
+          if (leaf == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          if (common == plen)
+            {
+              /* The new prefix is a parent of the node */
+
+              leaf->child[trie_bit(node->key, plen)] = node;
+              *pp = leaf;
+              return OK;
+            }
+
+          glue = trie_alloc(trie, key, common, NULL);
+          if (glue == NULL)
+            {
+              trie_free(trie, leaf);
+              return -ENOMEM;
+            }
+
+          glue->child[trie_bit(key, common)]       = leaf;
+          glue->child[trie_bit(node->key, common)] = node;
+          *pp = glue;
+          return OK;
+        }
+
+      if (node->plen == plen)
+        {
+          if (node->route != NULL)
+            {
+              *prev = node->route;
+              return -EEXIST;
+            }
+
+          node->route = route;
+          return OK;
+        }
+
+      pp = &node->child[trie_bit(key, node->plen)];
+    }
+
+  *pp = trie_alloc(trie, key, plen, route);
+  return *pp != NULL ? OK : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: trie_find
+ *
+ * Description:
+ *   Return the node holding exactly the prefix key/plen, or NULL.  The
+ *   link to the node and to its parent are returned as well.
+ *
+ ****************************************************************************/
+
+static FAR struct trie_node_s *
+trie_find(FAR struct trie_s *trie, FAR const uint8_t *key,
+          unsigned int plen, FAR struct trie_node_s ***ppp,
+          FAR struct trie_node_s ***parentpp)
+{
+  FAR struct trie_node_s **pp = &trie->root;
+  FAR struct trie_node_s *node;
+
+  *parentpp = NULL;
+  while ((node = *pp) != NULL && node->plen <= plen &&
+         trie_common(node->key, key, node->plen) == node->plen)
+    {
+      if (node->plen == plen)
+        {
+          *ppp = pp;
+          return node;
+        }
+
+      *parentpp = pp;
+      pp = &node->child[trie_bit(key, node->plen)];
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: trie_remove
+ *
+ * Description:
+ *   Replace the route of the prefix key/plen by 'next', removing the node
+ *   if 'next' is NULL and the node is no longer needed for branching.
+ *
+ ****************************************************************************/
+
+static void trie_remove(FAR struct trie_s *trie, FAR const uint8_t *key,
+                        unsigned int plen, FAR void *next)
+{
+  FAR struct trie_node_s **parentpp;
+  FAR struct trie_node_s **pp;
+  FAR struct trie_node_s *parent;
+  FAR struct trie_node_s *child;
+  FAR struct trie_node_s *node;
+
+  node = trie_find(trie, key, plen, &pp, &parentpp);
+  if (node == NULL)
+    {
+      return;
+    }
+
+  node->route = next;
+  if (next != NULL || (node->child[0] != NULL && node->child[1] != NULL))
+    {
+      return;
+    }
+
+  /* Splice the node out of the path */
+
+  child = node->child[0] != NULL ? node->child[0] : node->child[1];
+  *pp = child;
+  trie_free(trie, node);
+
+  /* A branch node left with a single child is not needed any more */
+
+  if (child == NULL && parentpp != NULL)
+    {
+      parent = *parentpp;
+      if (parent->route == NULL)
+        {
+          *parentpp = parent->child[0] != NULL ?
+                      parent->child[0] : parent->child[1];
+          trie_free(trie, parent);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: trie_foreach_match
+ *
+ * Description:
+ *   Visit the routes of every prefix that contains 'key', shortest prefix
+ *   first.  The traversal stops when 'visit' returns non-zero.
+ *
+ ****************************************************************************/
+
+static int trie_foreach_match(FAR struct trie_s *trie,
+                              FAR const uint8_t *key, unsigned int nbits,
+                              trie_visit_t visit, FAR void *arg)
+{
+  FAR struct trie_node_s *node = trie->root;
+  int ret = 0;
+
+  while (node != NULL &&
+         trie_common(node->key, key, node->plen) == node->plen)
+    {
+      if (node->route != NULL)
+        {
+          ret = visit(node->route, arg);
+          if (ret != 0)
+            {
+              break;
+            }
+        }
+
+      if (node->plen >= nbits)
+        {
+          break;
+        }
+
+      node = node->child[trie_bit(key, node->plen)];
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ramroute_ipv4_visit and ramroute_ipv6_visit
+ *
+ * Description:
+ *   Call the user handler for each route with the same prefix, in the
+ *   order the routes were added.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+struct ramroute_ipv4_visit_s
+{
+  route_handler_ipv4_t handler;
+  FAR void *arg;
+};
+
+static int ramroute_ipv4_visit(FAR void *route, FAR void *arg)
+{
+  FAR struct ramroute_ipv4_visit_s *visit = arg;
+  FAR struct net_route_ipv4_entry_s *entry = route;
+  int ret = 0;
+
+  for (; ret == 0 && entry != NULL; entry = entry->tnext)
+    {
+      ret = visit->handler(&entry->entry, visit->arg);
+    }
+
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+struct ramroute_ipv6_visit_s
+{
+  route_handler_ipv6_t handler;
+  FAR void *arg;
+};
+
+static int ramroute_ipv6_visit(FAR void *route, FAR void *arg)
+{
+  FAR struct ramroute_ipv6_visit_s *visit = arg;
+  FAR struct net_route_ipv6_entry_s *entry = route;
+  int ret = 0;
+
+  for (; ret == 0 && entry != NULL; entry = entry->tnext)
+    {
+      ret = visit->handler(&entry->entry, visit->arg);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ramroute_trie_init
+ *
+ * Description:
+ *   Initialize the lookup tries of the in-memory routing tables.
+ *
+ ****************************************************************************/
+
+void ramroute_trie_init(void)
+{
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+  trie_init(&g_ipv4_trie, g_ipv4_trie_nodes, TRIE_IPv4_NNODES);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+  trie_init(&g_ipv6_trie, g_ipv6_trie_nodes, TRIE_IPv6_NNODES);
+#endif
+}
+
+/****************************************************************************
+ * Name: ramroute_ipv4_trie_add and ramroute_ipv6_trie_add
+ *
+ * Description:
+ *   Index a new routing table entry.  Entries with the same target and
+ *   netmask are kept in the order they were added.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the netmask is not contiguous; -ENOMEM if
+ *   the trie is out of nodes.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int ramroute_ipv4_trie_add(FAR struct net_route_ipv4_entry_s *entry)
+{
+  FAR struct net_route_ipv4_entry_s *prev;
+  int plen;
+  int ret;
+
+  plen = trie_masklen((FAR const uint8_t *)&entry->entry.netmask, 32);
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  entry->tnext = NULL;
+  ret = trie_insert(&g_ipv4_trie, (FAR const uint8_t *)&entry->entry.target,
+                    plen, entry, (FAR void **)&prev);
+  if (ret == -EEXIST)
+    {
+      while (prev->tnext != NULL)
+        {
+          prev = prev->tnext;
+        }
+
+      prev->tnext = entry;
+      ret = OK;
+    }
+
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int ramroute_ipv6_trie_add(FAR struct net_route_ipv6_entry_s *entry)
+{
+  FAR struct net_route_ipv6_entry_s *prev;
+  int plen;
+  int ret;
+
+  plen = trie_masklen((FAR const uint8_t *)entry->entry.netmask, 128);
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  entry->tnext = NULL;
+  ret = trie_insert(&g_ipv6_trie, (FAR const uint8_t *)entry->entry.target,
+                    plen, entry, (FAR void **)&prev);
+  if (ret == -EEXIST)
+    {
+      while (prev->tnext != NULL)
+        {
+          prev = prev->tnext;
+        }
+
+      prev->tnext = entry;
+      ret = OK;
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: ramroute_ipv4_trie_del and ramroute_ipv6_trie_del
+ *
+ * Description:
+ *   Remove a routing table entry from the index.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void ramroute_ipv4_trie_del(FAR struct net_route_ipv4_entry_s *entry)
+{
+  FAR const uint8_t *key = (FAR const uint8_t *)&entry->entry.target;
+  FAR struct net_route_ipv4_entry_s **pp;
+  FAR struct trie_node_s **parentpp;
+  FAR struct trie_node_s **nodepp;
+  FAR struct trie_node_s *node;
+  int plen;
+
+  plen = trie_masklen((FAR const uint8_t *)&entry->entry.netmask, 32);
+  node = plen < 0 ? NULL :
+         trie_find(&g_ipv4_trie, key, plen, &nodepp, &parentpp);
+  if (node == NULL)
+    {
+      return;
+    }
+
+  if (node->route == entry)
+    {
+      trie_remove(&g_ipv4_trie, key, plen, entry->tnext);
+      return;
+    }
+
+  for (pp = (FAR struct net_route_ipv4_entry_s **)&node->route;
+       *pp != NULL; pp = &(*pp)->tnext)
+    {
+      if (*pp == entry)
+        {
+          *pp = entry->tnext;
+          break;
+        }
+    }
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void ramroute_ipv6_trie_del(FAR struct net_route_ipv6_entry_s *entry)
+{
+  FAR const uint8_t *key = (FAR const uint8_t *)entry->entry.target;
+  FAR struct net_route_ipv6_entry_s **pp;
+  FAR struct trie_node_s **parentpp;
+  FAR struct trie_node_s **nodepp;
+  FAR struct trie_node_s *node;
+  int plen;
+
+  plen = trie_masklen((FAR const uint8_t *)entry->entry.netmask, 128);
+  node = plen < 0 ? NULL :
+         trie_find(&g_ipv6_trie, key, plen, &nodepp, &parentpp);
+  if (node == NULL)
+    {
+      return;
+    }
+
+  if (node->route == entry)
+    {
+      trie_remove(&g_ipv6_trie, key, plen, entry->tnext);
+      return;
+    }
+
+  for (pp = (FAR struct net_route_ipv6_entry_s **)&node->route;
+       *pp != NULL; pp = &(*pp)->tnext)
+    {
+      if (*pp == entry)
+        {
+          *pp = entry->tnext;
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: net_foreachmatch_ipv4 and net_foreachmatch_ipv6
+ *
+ * Description:
+ *   Like net_foreachroute_ipv4/6(), but only the routes whose network
+ *   contains 'target' are visited, from the shortest to the longest
+ *   prefix.  The cost depends on the prefix length, not on the number of
+ *   routes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_foreachmatch_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                          FAR void *arg)
+{
+  struct ramroute_ipv4_visit_s visit;
+  int ret;
+
+  visit.handler = handler;
+  visit.arg     = arg;
+
+  net_lock();
+  ret = trie_foreach_match(&g_ipv4_trie, (FAR const uint8_t *)&target, 32,
+                           ramroute_ipv4_visit, &visit);
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_foreachmatch_ipv6(FAR const uint16_t *target,
+                          route_handler_ipv6_t handler, FAR void *arg)
+{
+  struct ramroute_ipv6_visit_s visit;
+  int ret;
+
+  visit.handler = handler;
+  visit.arg     = arg;
+
+  net_lock();
+  ret = trie_foreach_match(&g_ipv6_trie, (FAR const uint8_t *)target, 128,
+                           ramroute_ipv6_visit, &visit);
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_RAMROUTE_TRIE */
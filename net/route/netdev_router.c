@@ -284,7 +284,7 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_devmatch, &match);
+      ret = net_foreachmatch_ipv4(target, net_ipv4_devmatch, &match);
     }
 
   /* Did we find a route? */
@@ -371,7 +371,7 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_devmatch, &match);
+      ret = net_foreachmatch_ipv6(target, net_ipv6_devmatch, &match);
     }
 
   /* Did we find a route? */
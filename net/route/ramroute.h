@@ -68,6 +68,9 @@ struct net_route_ipv4_entry_s
 {
   struct net_route_ipv4_s entry;
   FAR struct net_route_ipv4_entry_s *flink;
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  FAR struct net_route_ipv4_entry_s *tnext; /* Next route, same prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -86,6 +89,9 @@ struct net_route_ipv6_entry_s
 {
   struct net_route_ipv6_s entry;
   FAR struct net_route_ipv6_entry_s *flink;
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+  FAR struct net_route_ipv6_entry_s *tnext; /* Next route, same prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -218,5 +224,74 @@ ramroute_ipv6_remafter(FAR struct net_route_ipv6_entry_s *entry,
                        FAR struct net_route_ipv6_queue_s *list);
 #endif
 
+/****************************************************************************
+ * Name: ramroute_trie_init
+ *
+ * Description:
+ *   Initialize the longest-prefix-match tries that index the in-memory
+ *   routing tables.
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+void ramroute_trie_init(void);
+#endif
+
+/****************************************************************************
+ * Name: ramroute_ipv4_trie_add/ramroute_ipv6_trie_add
+ *
+ * Description:
+ *   Add a routing table entry to the lookup trie.
+ *
+ * Input Parameters:
+ *   entry - The entry to index
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if the netmask is not contiguous; -ENOMEM if
+ *   the trie has no free node.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+#  ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int ramroute_ipv4_trie_add(FAR struct net_route_ipv4_entry_s *entry);
+#  endif
+#  ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int ramroute_ipv6_trie_add(FAR struct net_route_ipv6_entry_s *entry);
+#  endif
+#endif
+
+/****************************************************************************
+ * Name: ramroute_ipv4_trie_del/ramroute_ipv6_trie_del
+ *
+ * Description:
+ *   Remove a routing table entry from the lookup trie.
+ *
+ * Input Parameters:
+ *   entry - The entry to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_RAMROUTE_TRIE
+#  ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void ramroute_ipv4_trie_del(FAR struct net_route_ipv4_entry_s *entry);
+#  endif
+#  ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void ramroute_ipv6_trie_del(FAR struct net_route_ipv6_entry_s *entry);
+#  endif
+#endif
+
 #endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
 #endif /* __NET_ROUTE_RAMROUTE_H */
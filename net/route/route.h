@@ -283,6 +283,45 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg);
 int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: net_foreachmatch_ipv4/net_foreachmatch_ipv6
+ *
+ * Description:
+ *   Traverse the routes that may match 'target'.  With the in-memory
+ *   routing table indexed by a trie (CONFIG_ROUTE_RAMROUTE_TRIE), only the
+ *   routes whose network contains 'target' are visited, shortest prefix
+ *   first.  Otherwise this is net_foreachroute_ipv4/6().
+ *
+ * Input Parameters:
+ *   target  - The destination address to be routed.
+ *   handler - Will be called for each candidate route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Same as net_foreachroute_ipv4/6().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+#  if defined(CONFIG_ROUTE_RAMROUTE_TRIE) && \
+      defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+int net_foreachmatch_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                          FAR void *arg);
+#  else
+#    define net_foreachmatch_ipv4(t,h,a) net_foreachroute_ipv4(h,a)
+#  endif
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#  if defined(CONFIG_ROUTE_RAMROUTE_TRIE) && \
+      defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+int net_foreachmatch_ipv6(FAR const uint16_t *target,
+                          route_handler_ipv6_t handler, FAR void *arg);
+#  else
+#    define net_foreachmatch_ipv6(t,h,a) net_foreachroute_ipv6(h,a)
+#  endif
+#endif
+
 /****************************************************************************
  * Name: net_ipv4_dumproute and net_ipv6_dumproute
  *
@@ -0,0 +1,218 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives a batch of messages from a socket.  This is
+ *   an internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   If the address family reports SOCKCAP_NETBATCH, the receives that
+ *   cannot block are done under a single hold of the network lock.  A
+ *   receive that may wait for data is done without it, since it would
+ *   break the lock while waiting anyway.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers for the received messages.  The msg_len field of each
+ *            message received is set to the number of bytes received.
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags.  MSG_WAITFORONE makes every receive after the
+ *            first one non-blocking.
+ *   timeout  If not NULL, no further messages are waited for once this
+ *            much time has elapsed.  As on other systems, the timeout is
+ *            only checked after each message is received.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If the first
+ *   receive fails, a negated errno value is returned (see comments with
+ *   recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR const struct timespec *timeout)
+{
+  FAR struct socket_conn_s *conn;
+  clock_t deadline = 0;
+  unsigned int i;
+  bool locked = false;
+  bool batch;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EFAULT;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      deadline = clock_systime_ticks() + clock_time2ticks(timeout);
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL &&
+              psock->s_sockif->si_sockcaps != NULL);
+
+  conn  = psock->s_conn;
+  batch = (psock->s_sockif->si_sockcaps(psock) & SOCKCAP_NETBATCH) != 0;
+
+  for (i = 0; i < vlen; i++)
+    {
+      /* Take the network lock once the remaining receives cannot block */
+
+      if (batch && !locked && ((flags & MSG_DONTWAIT) != 0 ||
+                               _SS_ISNONBLOCK(conn->s_flags)))
+        {
+          net_lock();
+          locked = true;
+        }
+
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      /* Don't wait for more once one message has been received */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL && clock_compare(deadline, clock_systime_ticks()))
+        {
+          i++;
+          break;
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  return i > 0 ? (int)i : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   The recvmmsg() call receives up to 'vlen' messages with a single call.
+ *   It is equivalent to calling recvmsg() once for each message.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers for the received messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *   timeout  Time limit for the batch, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received and sets the
+ *   msg_len of each of these to the number of bytes received.  On error,
+ *   -1 is returned, and errno is set appropriately (see recvmsg()).  An
+ *   error is only returned if no message was received.
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
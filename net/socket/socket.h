@@ -60,6 +60,7 @@
 #define _SO_RCVLOWAT     _SO_BIT(SO_RCVLOWAT)
 #define _SO_RCVTIMEO     _SO_BIT(SO_RCVTIMEO)
 #define _SO_REUSEADDR    _SO_BIT(SO_REUSEADDR)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
 #define _SO_SNDBUF       _SO_BIT(SO_SNDBUF)
 #define _SO_SNDLOWAT     _SO_BIT(SO_SNDLOWAT)
 #define _SO_SNDTIMEO     _SO_BIT(SO_SNDTIMEO)
@@ -69,7 +70,7 @@
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (18)
+#define _SO_MAXOPT       (19)
 
 /* Macros to set, test, clear options */
 
@@ -208,6 +208,11 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  dq_entry_t hnode;       /* Link in the active connection hash table */
+  dq_entry_t lnode;       /* Link in the listener hash table */
+#endif
+
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -1066,6 +1071,27 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno);
 #endif
 
+/****************************************************************************
+ * Name: tcp_reuseport_select
+ *
+ * Description:
+ *   If 'listener' belongs to an SO_REUSEPORT group, return the member of
+ *   the group that accepts connections from this remote address and port
+ *   (network byte order).  Otherwise, 'listener' is returned.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct tcp_conn_s *
+tcp_reuseport_select(FAR struct tcp_conn_s *listener,
+                     FAR const union ip_addr_u *raddr, uint16_t rport);
+#else
+#  define tcp_reuseport_select(l,a,p) (l)
+#endif
+
 /****************************************************************************
  * Name: tcp_unlisten
  *
@@ -81,6 +81,20 @@
 #  define CONFIG_NET_TCP_MAX_CONNS 0
 #endif
 
+/* Iterate over the active connections that may match an incoming segment
+ * whose (local port, remote port, remote address) hashes to bucket 'h'.
+ * Without the hash table all active connections are candidates.
+ */
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_ACTIVE_FIRST(h) tcp_hashconn(g_tcp_connhash[h].head)
+#  define TCP_ACTIVE_NEXT(c)  tcp_hashconn((c)->hnode.flink)
+#else
+#  define TCP_ACTIVE_FIRST(h) \
+     ((FAR struct tcp_conn_s *)g_active_tcp_connections.head)
+#  define TCP_ACTIVE_NEXT(c)  ((FAR struct tcp_conn_s *)(c)->sconn.node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -95,10 +109,124 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The active connections indexed by (lport, rport, raddr) */
+
+static dq_queue_t g_tcp_connhash[CONFIG_NET_TCP_CONN_HASHSIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+
+/****************************************************************************
+ * Name: tcp_hashconn
+ *
+ * Description:
+ *   Return the connection owning a hash table link, or NULL.
+ *
+ ****************************************************************************/
+
+static inline FAR struct tcp_conn_s *tcp_hashconn(FAR dq_entry_t *node)
+{
+  return node ? container_of(node, struct tcp_conn_s, hnode) : NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_hashkey
+ *
+ * Description:
+ *   Compute the hash bucket of a connection from its local port, remote
+ *   port (both in network byte order) and its remote address folded to
+ *   32 bits.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_hashkey(uint16_t lport, uint16_t rport,
+                                uint32_t raddr)
+{
+  uint32_t hash = raddr ^ (((uint32_t)lport << 16) | rport);
+
+  /* Mix the bits so that sequential ports and addresses spread out */
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash % CONFIG_NET_TCP_CONN_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_ipv6_fold
+ *
+ * Description:
+ *   Fold an IPv6 address to 32 bits for hashing.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *addr)
+{
+  return ((uint32_t)(addr[0] ^ addr[2] ^ addr[4] ^ addr[6]) << 16) |
+         (addr[1] ^ addr[3] ^ addr[5] ^ addr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_connhash
+ *
+ * Description:
+ *   Return the hash bucket of a connection that is (being) put into the
+ *   active list.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_connhash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport,
+                         tcp_ipv6_fold(conn->u.ipv6.raddr));
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
+/****************************************************************************
+ * Name: tcp_addactive
+ *
+ * Description:
+ *   Put a connection whose local and remote port and address are set into
+ *   the active list (and the active hash table).
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_addactive(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  dq_addlast(&conn->hnode, &g_tcp_connhash[tcp_connhash(conn)]);
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -193,9 +321,14 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = TCP_ACTIVE_FIRST(tcp_hashkey(tcp->destport, tcp->srcport,
+                                            srcipaddr));
+#else
+  conn       = TCP_ACTIVE_FIRST(0);
+#endif
 
   while (conn)
     {
@@ -232,7 +365,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = TCP_ACTIVE_NEXT(conn);
     }
 
   return conn;
@@ -260,9 +393,14 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = TCP_ACTIVE_FIRST(tcp_hashkey(tcp->destport, tcp->srcport,
+                                            tcp_ipv6_fold(*srcipaddr)));
+#else
+  conn       = TCP_ACTIVE_FIRST(0);
+#endif
 
   while (conn)
     {
@@ -299,7 +437,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = TCP_ACTIVE_NEXT(conn);
     }
 
   return conn;
@@ -858,6 +996,9 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      dq_rem(&conn->hnode, &g_tcp_connhash[tcp_connhash(conn)]);
+#endif
     }
 
   tcp_free_rx_buffers(conn);
@@ -1154,7 +1295,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_addactive(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1465,7 +1606,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_addactive(conn);
   ret = OK;
 
 errout_with_lock:
@@ -800,6 +800,32 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
       if ((conn = tcp_findlistener(&uaddr, tmp16)) != NULL)
 #endif
         {
+#ifdef CONFIG_NET_SOCKOPTS
+          union ip_addr_u raddr;
+
+          /* Spread new connections over an SO_REUSEPORT group */
+
+#  ifdef CONFIG_NET_IPv6
+#    ifdef CONFIG_NET_IPv4
+          if (domain == PF_INET6)
+#    endif
+            {
+              net_ipv6addr_copy(raddr.ipv6, IPv6BUF->srcipaddr);
+            }
+#  endif
+
+#  ifdef CONFIG_NET_IPv4
+#    ifdef CONFIG_NET_IPv6
+          if (domain == PF_INET)
+#    endif
+            {
+              raddr.ipv4 = net_ip4addr_conv32(IPv4BUF->srcipaddr);
+            }
+#  endif
+
+          conn = tcp_reuseport_select(conn, &raddr, tcp->srcport);
+#endif
+
           if (!tcp_backlogavailable(conn))
             {
               nerr("ERROR: no free containers for TCP BACKLOG!\n");
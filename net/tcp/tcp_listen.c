@@ -55,20 +55,225 @@
 
 #include "devif/devif.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The domain argument is only meaningful if both IPv4 and IPv6 are on */
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+#  define TCP_LISTENER_MATCH(c,u,p,d) tcp_listener_match(c,u,p,d)
+#else
+#  define TCP_LISTENER_MATCH(c,u,p,d) tcp_listener_match(c,u,p,0)
+#endif
+
+/* The listener hash uses one bucket per permitted listening port */
+
+#define TCP_LISTEN_HASH(portno) (NTOHS(portno) % CONFIG_NET_MAX_LISTENPORTS)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The listening connections indexed by local port, and their number */
+
+static dq_queue_t g_tcp_listenhash[CONFIG_NET_MAX_LISTENPORTS];
+static int g_tcp_nlisteners;
+#else
 /* The tcp_listenports list all currently listening ports. */
 
 static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_listener_match
+ *
+ * Description:
+ *   Return true if the listening connection accepts connections on this
+ *   local address and port.
+ *
+ ****************************************************************************/
+
+static bool tcp_listener_match(FAR struct tcp_conn_s *conn,
+                               FAR union ip_binding_u *uaddr,
+                               uint16_t portno, uint8_t domain)
+{
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  if (conn->lport != portno || conn->domain != domain)
+#else
+  if (conn->lport != portno)
+#endif
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (domain == PF_INET6)
+#  endif
+    {
+      if (net_ipv6addr_cmp(conn->u.ipv6.laddr, uaddr->ipv6.laddr) ||
+          net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
+        {
+          return true;
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET)
+#  endif
+    {
+      if (net_ipv4addr_cmp(conn->u.ipv4.laddr, uaddr->ipv4.laddr) ||
+          net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
+        {
+          return true;
+        }
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_reuseport_match
+ *
+ * Description:
+ *   Return true if both listening connections have SO_REUSEPORT set and
+ *   are bound to the same local address and port, i.e., they belong to the
+ *   same SO_REUSEPORT group.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+static bool tcp_reuseport_match(FAR struct tcp_conn_s *conn1,
+                                FAR struct tcp_conn_s *conn2)
+{
+  if (!_SO_GETOPT(conn1->sconn.s_options, SO_REUSEPORT) ||
+      !_SO_GETOPT(conn2->sconn.s_options, SO_REUSEPORT) ||
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      conn1->domain != conn2->domain ||
+#endif
+      conn1->lport != conn2->lport)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (conn1->domain == PF_INET6)
+#  endif
+    {
+      return net_ipv6addr_cmp(conn1->u.ipv6.laddr, conn2->u.ipv6.laddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      return net_ipv4addr_cmp(conn1->u.ipv4.laddr, conn2->u.ipv4.laddr);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_reuseport_member
+ *
+ * Description:
+ *   Return the member at position 'index' of the SO_REUSEPORT group of
+ *   'listener', or NULL if there is no such member.  The size of the group
+ *   is returned in 'count' when the whole group has been examined (e.g.,
+ *   for a negative index).
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *
+tcp_reuseport_member(FAR struct tcp_conn_s *listener, int index,
+                     FAR int *count)
+{
+  FAR struct tcp_conn_s *conn;
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_entry_t *node;
+#else
+  int ndx;
+#endif
+  int n = 0;
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  for (node = dq_peek(&g_tcp_listenhash[TCP_LISTEN_HASH(listener->lport)]);
+       node != NULL;
+       node = dq_next(node))
+    {
+      conn = container_of(node, struct tcp_conn_s, lnode);
+#else
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      conn = tcp_listenports[ndx];
+      if (conn == NULL)
+        {
+          continue;
+        }
+#endif
+
+      if (tcp_reuseport_match(listener, conn) && n++ == index)
+        {
+          return conn;
+        }
+    }
+
+  *count = n;
+  return NULL;
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
+/****************************************************************************
+ * Name: tcp_islistening
+ *
+ * Description:
+ *   Return true if 'conn' itself is already in the listener list.
+ *
+ ****************************************************************************/
+
+static bool tcp_islistening(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_entry_t *node;
+
+  for (node = dq_peek(&g_tcp_listenhash[TCP_LISTEN_HASH(conn->lport)]);
+       node != NULL;
+       node = dq_next(node))
+    {
+      if (node == &conn->lnode)
+        {
+          return true;
+        }
+    }
+#else
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      if (tcp_listenports[ndx] == conn)
+        {
+          return true;
+        }
+    }
+#endif
+
+  return false;
+}
+
 /****************************************************************************
  * Name: tcp_findlistener
  *
@@ -89,6 +294,26 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_entry_t *node;
+
+  /* Only the listeners hashed to the same bucket can match this port */
+
+  for (node = dq_peek(&g_tcp_listenhash[TCP_LISTEN_HASH(portno)]);
+       node != NULL;
+       node = dq_next(node))
+    {
+      FAR struct tcp_conn_s *conn =
+        container_of(node, struct tcp_conn_s, lnode);
+
+      if (TCP_LISTENER_MATCH(conn, uaddr, portno, domain))
+        {
+          /* Yes.. we found a listener on this port */
+
+          return conn;
+        }
+    }
+#else
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
@@ -100,43 +325,14 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
        */
 
       FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
-#else
-      if (conn && conn->lport == portno)
-#endif
+      if (conn && TCP_LISTENER_MATCH(conn, uaddr, portno, domain))
         {
-#ifdef CONFIG_NET_IPv6
-#  ifdef CONFIG_NET_IPv4
-          if (domain == PF_INET6)
-#  endif
-            {
-              if (net_ipv6addr_cmp(conn->u.ipv6.laddr, uaddr->ipv6.laddr) ||
-                  net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
-                {
-                  /* Yes.. we found a listener on this port */
-
-                  return conn;
-                }
-            }
-#endif
-
-#ifdef CONFIG_NET_IPv4
-#  ifdef CONFIG_NET_IPv6
-          if (domain == PF_INET)
-#  endif
-            {
-              if (net_ipv4addr_cmp(conn->u.ipv4.laddr, uaddr->ipv4.laddr) ||
-                  net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
-                {
-                  /* Yes.. we found a listener on this port */
+          /* Yes.. we found a listener on this port */
 
-                  return conn;
-                }
-            }
-#endif
+          return conn;
         }
     }
+#endif
 
   /* No listener for this port */
 
@@ -160,10 +356,28 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR dq_queue_t *bucket;
+  FAR dq_entry_t *node;
+#else
   int ndx;
+#endif
   int ret = -EINVAL;
 
   net_lock();
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  bucket = &g_tcp_listenhash[TCP_LISTEN_HASH(conn->lport)];
+  for (node = dq_peek(bucket); node != NULL; node = dq_next(node))
+    {
+      if (node == &conn->lnode)
+        {
+          dq_rem(node, bucket);
+          g_tcp_nlisteners--;
+          ret = OK;
+          break;
+        }
+    }
+#else
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       if (tcp_listenports[ndx] == conn)
@@ -173,6 +387,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
           break;
         }
     }
+#endif
 
   net_unlock();
   return ret;
@@ -191,7 +406,10 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+  FAR struct tcp_conn_s *listener;
+#ifndef CONFIG_NET_TCP_CONN_HASH
   int ndx;
+#endif
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -200,13 +418,31 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
   net_lock();
 
-  /* First, check if there is already a socket listening on this port */
+  /* listen() on a socket that is already listening just succeeds.  It must
+   * not be linked into the listener list a second time.
+   */
+
+  if (tcp_islistening(conn))
+    {
+      net_unlock();
+      return OK;
+    }
+
+  /* Check if there is already another socket listening on this port.
+   * That is only allowed if both sockets join the same SO_REUSEPORT group.
+   */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  if (tcp_islistener(&conn->u, conn->lport, conn->domain))
+  listener = tcp_findlistener(&conn->u, conn->lport, conn->domain);
 #else
-  if (tcp_islistener(&conn->u, conn->lport))
+  listener = tcp_findlistener(&conn->u, conn->lport);
 #endif
+
+  if (listener != NULL
+#ifdef CONFIG_NET_SOCKOPTS
+      && !tcp_reuseport_match(listener, conn)
+#endif
+     )
     {
       /* Yes, then we must refuse this request */
 
@@ -220,6 +456,15 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
       ret = -ENOBUFS; /* Assume failure */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      if (g_tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
+        {
+          dq_addlast(&conn->lnode,
+                     &g_tcp_listenhash[TCP_LISTEN_HASH(conn->lport)]);
+          g_tcp_nlisteners++;
+          ret = OK;
+        }
+#else
       /* Search all slots until an available slot is found */
 
       for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
@@ -235,6 +480,7 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
               break;
             }
         }
+#endif
     }
 
   net_unlock();
@@ -265,6 +511,74 @@ bool tcp_islistener(FAR union ip_binding_u *uaddr, uint16_t portno)
 }
 #endif
 
+/****************************************************************************
+ * Name: tcp_reuseport_select
+ *
+ * Description:
+ *   If 'listener' belongs to an SO_REUSEPORT group, return the member of
+ *   the group that should accept the connection from this remote address
+ *   and port.  The choice depends only on the remote endpoint, so every
+ *   packet of the handshake resolves to the same listener as long as the
+ *   group does not change.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct tcp_conn_s *
+tcp_reuseport_select(FAR struct tcp_conn_s *listener,
+                     FAR const union ip_addr_u *raddr, uint16_t rport)
+{
+  FAR struct tcp_conn_s *conn;
+  uint32_t hash;
+  int count;
+
+  if (!_SO_GETOPT(listener->sconn.s_options, SO_REUSEPORT))
+    {
+      return listener;
+    }
+
+  tcp_reuseport_member(listener, -1, &count);
+  if (count <= 1)
+    {
+      return listener;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (listener->domain == PF_INET6)
+#  endif
+    {
+      FAR const uint16_t *addr = raddr->ipv6;
+
+      hash = ((uint32_t)(addr[0] ^ addr[2] ^ addr[4] ^ addr[6]) << 16) |
+             (addr[1] ^ addr[3] ^ addr[5] ^ addr[7]);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      hash = raddr->ipv4;
+    }
+#endif
+
+  /* Mix the bits so that neighbouring clients spread over the group */
+
+  hash ^= rport;
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  conn = tcp_reuseport_member(listener, hash % count, &count);
+  return conn != NULL ? conn : listener;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_accept_connection
  *
@@ -294,6 +608,36 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
 #endif
   if (listener != NULL)
     {
+#ifdef CONFIG_NET_SOCKOPTS
+      /* Hand the connection to the same member of an SO_REUSEPORT group
+       * that answered the SYN.
+       */
+
+#  ifdef CONFIG_NET_IPv6
+#    ifdef CONFIG_NET_IPv4
+      if (conn->domain == PF_INET6)
+#    endif
+        {
+          union ip_addr_u raddr;
+
+          net_ipv6addr_copy(raddr.ipv6, conn->u.ipv6.raddr);
+          listener = tcp_reuseport_select(listener, &raddr, conn->rport);
+        }
+#  endif
+
+#  ifdef CONFIG_NET_IPv4
+#    ifdef CONFIG_NET_IPv6
+      else
+#    endif
+        {
+          union ip_addr_u raddr;
+
+          raddr.ipv4 = conn->u.ipv4.raddr;
+          listener   = tcp_reuseport_select(listener, &raddr, conn->rport);
+        }
+#  endif
+#endif
+
       /* Yes, there is a listener.  Is it accepting connections now? */
 
       if (listener->accept)
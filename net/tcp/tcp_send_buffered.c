@@ -318,6 +318,57 @@ static inline void psock_lost_connection(FAR struct tcp_conn_s *conn,
     }
 }
 
+/****************************************************************************
+ * Name: tcp_max_sndlen
+ *
+ * Description:
+ *   Return the largest amount of data that may be sent in one packet.
+ *   This is the MSS unless the device can segment the packet itself, in
+ *   which case it is the largest whole number of MSS-sized segments that
+ *   fits in the device's segmentation offload size.
+ *
+ * Input Parameters:
+ *   dev  - The device the packet will be sent on
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_max_sndlen(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_GSO
+  uint32_t nsegs;
+
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain != PF_INET)
+    {
+      dev->d_gsomss = 0;
+      return conn->mss;
+    }
+#endif
+
+  nsegs = 0;
+  if (dev->d_gsosize > NETDEV_PKTSIZE(dev) && conn->mss > 0)
+    {
+      nsegs = (dev->d_gsosize - NET_LL_HDRLEN(dev) - tcpip_hdrsize(conn)) /
+              conn->mss;
+    }
+
+  if (nsegs > 1)
+    {
+      dev->d_gsomss = conn->mss;
+      return nsegs * conn->mss;
+    }
+
+  dev->d_gsomss = 0;
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: parse_sack
  *
@@ -1037,12 +1088,14 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
+          uint32_t maxlen;
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          maxlen = tcp_max_sndlen(dev, conn);
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
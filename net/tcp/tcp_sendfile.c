@@ -73,6 +73,9 @@ struct sendfile_s
   FAR struct tcp_conn_s *snd_conn;         /* Connection associated with the socket */
   FAR struct devif_callback_s *snd_cb;     /* Reference to callback instance */
   FAR struct file   *snd_file;             /* File structure of the input file */
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR const uint8_t *snd_xipbase;          /* Directly addressable file data */
+#endif
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
@@ -96,6 +99,63 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+/****************************************************************************
+ * Name: sendfile_xipbase
+ *
+ * Description:
+ *   Return the address of the file data if it can be sent in place (see
+ *   file_xipbase()), clamping 'count' to the end of the file.  NULL means
+ *   that the data has to be read into IOBs.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *sendfile_xipbase(FAR struct file *infile,
+                                           off_t offset, FAR size_t *count)
+{
+  FAR const uint8_t *base;
+  off_t size;
+
+  base = file_xipbase(infile, &size);
+  if (base == NULL || offset >= size)
+    {
+      return NULL;
+    }
+
+  if (*count > size - offset)
+    {
+      *count = size - offset;
+    }
+
+  return base;
+}
+#endif
+
+/****************************************************************************
+ * Name: sendfile_send
+ *
+ * Description:
+ *   Set up 'sndlen' bytes from file offset 'offset' as the payload of the
+ *   next TCP segment.
+ *
+ ****************************************************************************/
+
+static int sendfile_send(FAR struct net_driver_s *dev,
+                         FAR struct sendfile_s *pstate,
+                         unsigned int sndlen, off_t offset)
+{
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  if (pstate->snd_xipbase != NULL)
+    {
+      return devif_xip_send(dev, pstate->snd_xipbase + offset, sndlen,
+                            tcpip_hdrsize(pstate->snd_conn));
+    }
+#endif
+
+  return devif_file_send(dev, pstate->snd_file, sndlen, offset,
+                         tcpip_hdrsize(pstate->snd_conn));
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -269,9 +329,8 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                            pstate->snd_foffset + pstate->snd_acked,
-                            tcpip_hdrsize(conn));
+      ret = sendfile_send(dev, pstate, sndlen,
+                          pstate->snd_foffset + pstate->snd_acked);
       if (ret < 0)
         {
           nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -340,9 +399,8 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = devif_file_send(dev, pstate->snd_file, sndlen,
-                                pstate->snd_foffset + pstate->snd_sent,
-                                tcpip_hdrsize(conn));
+          ret = sendfile_send(dev, pstate, sndlen,
+                              pstate->snd_foffset + pstate->snd_sent);
           if (ret < 0)
             {
               nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -418,6 +476,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR const uint8_t *xipbase;
+#endif
   off_t startpos;
   int ret = OK;
 
@@ -470,6 +531,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  xipbase = sendfile_xipbase(infile, offset ? *offset : startpos, &count);
+#endif
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -486,6 +551,9 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : startpos; /* Input file offset */
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  state.snd_xipbase = xipbase;                     /* Or its data in place */
+#endif
 
   /* Allocate resources to receive a callback */
 
@@ -545,6 +613,15 @@ errout_locked:
 #endif
   net_unlock();
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* Nothing was read, so advance the file position as reading would */
+
+  if (state.snd_xipbase != NULL && state.snd_sent > 0)
+    {
+      file_seek(infile, state.snd_foffset + state.snd_sent, SEEK_SET);
+    }
+#endif
+
   /* Return the current file position */
 
   if (offset)
@@ -174,6 +174,7 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+  uint16_t wb_sum;                 /* chksum() of the payload */
 };
 #endif
 
@@ -250,6 +251,25 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
                                   FAR struct udp_conn_s *conn,
                                   FAR struct udp_hdr_s *udp);
 
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   Select the member of an SO_REUSEPORT group that receives the unicast
+ *   datagram in the device buffer.  'conn' is returned if it is not in
+ *   such a group.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport_select(FAR struct net_driver_s *dev,
+                                            FAR struct udp_conn_s *conn,
+                                            FAR struct udp_hdr_s *udp);
+#endif
+
 /****************************************************************************
  * Name: udp_nextconn
  *
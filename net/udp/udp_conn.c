@@ -113,6 +113,7 @@ static dq_queue_t g_active_udp_connections;
  *   portno - The port to use in the lookup
  *   opt    - The option from another conn to match the conflict conn
  *              SO_REUSEADDR: If both sockets have this, they never confilct.
+ *              SO_REUSEPORT: Likewise.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -126,6 +127,7 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   FAR struct udp_conn_s *conn = NULL;
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
 #endif
 
   /* Now search each connection structure. */
@@ -141,6 +143,13 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
         {
           continue;
         }
+
+      /* The same for members of an SO_REUSEPORT group */
+
+      if (skip_reuseport && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          continue;
+        }
 #endif
 
       /* If the port local port number assigned to the connections matches
@@ -692,6 +701,87 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 #endif /* CONFIG_NET_IPv4 */
 }
 
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   'conn' is the first connection that accepts the unicast datagram in
+ *   the device buffer.  If it has SO_REUSEPORT set, pick one of all the
+ *   SO_REUSEPORT connections that accept the datagram, by a hash of the
+ *   source address and port, so that the load of a flow always lands on
+ *   the same socket.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SOCKOPTS
+FAR struct udp_conn_s *udp_reuseport_select(FAR struct net_driver_s *dev,
+                                            FAR struct udp_conn_s *conn,
+                                            FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *member;
+  uint32_t hash;
+  int count = 0;
+
+  if (!_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+    {
+      return conn;
+    }
+
+  for (member = conn; member != NULL; member = udp_active(dev, member, udp))
+    {
+      if (_SO_GETOPT(member->sconn.s_options, SO_REUSEPORT))
+        {
+          count++;
+        }
+    }
+
+  if (count <= 1)
+    {
+      return conn;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR const uint16_t *addr = IPv6BUF->srcipaddr;
+
+      hash = ((uint32_t)(addr[0] ^ addr[2] ^ addr[4] ^ addr[6]) << 16) |
+             (addr[1] ^ addr[3] ^ addr[5] ^ addr[7]);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      hash = net_ip4addr_conv32(IPv4BUF->srcipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  hash ^= udp->srcport;
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+  hash %= count;
+
+  for (member = conn; member != NULL; member = udp_active(dev, member, udp))
+    {
+      if (_SO_GETOPT(member->sconn.s_options, SO_REUSEPORT) && hash-- == 0)
+        {
+          return member;
+        }
+    }
+
+  return conn;
+}
+#endif /* CONFIG_NET_SOCKOPTS */
+
 /****************************************************************************
  * Name: udp_nextconn
  *
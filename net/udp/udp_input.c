@@ -324,6 +324,16 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
                   conn = nextconn;
                 }
             }
+          else
+#endif
+#ifdef CONFIG_NET_SOCKOPTS
+            {
+              /* A unicast datagram goes to one member of an SO_REUSEPORT
+               * group.
+               */
+
+              conn = udp_reuseport_select(dev, conn, udp);
+            }
 #endif
 
           /* We can deliver the packet directly to the last listener. */
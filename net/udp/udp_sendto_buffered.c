@@ -448,7 +448,9 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
        * window size.
        */
 
-      dev->d_sndlen = wrb->wb_iob->io_pktlen - udpiplen;
+      dev->d_sndlen    = wrb->wb_iob->io_pktlen - udpiplen;
+      dev->d_sndsum    = wrb->wb_sum;
+      dev->d_sndsumlen = dev->d_sndlen;
       ninfo("wrb=%p sndlen=%d\n", wrb, dev->d_sndlen);
 
       /* Do not need to release wb_iob, the life cycle of wb_iob is
@@ -548,6 +550,7 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct udp_wrbuffer_s *wrb;
   FAR struct udp_conn_s *conn;
+  struct chksum_copy_s state;
   unsigned int timeout;
   uint16_t udpiplen;
   bool nonblock;
@@ -813,14 +816,19 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       iob_reserve(wrb->wb_iob, CONFIG_NET_LL_GUARDSIZE);
       iob_update_pktlen(wrb->wb_iob, udpiplen, false);
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+      /* Copy the user data into the write buffer, summing it on the way
+       * for the UDP checksum.  We cannot wait for buffer space if the
+       * socket was opened non-blocking.
        */
 
+      state.sum = 0;
+      state.odd = false;
+
       if (nonblock)
         {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                              len, udpiplen, false);
+          ret = iob_copyin_fn(wrb->wb_iob, (FAR uint8_t *)buf,
+                              len, udpiplen, false, false,
+                              chksum_copy, &state);
         }
       else
         {
@@ -833,8 +841,9 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
            */
 
           blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                           len, udpiplen, false);
+          ret = iob_copyin_fn(wrb->wb_iob, (FAR uint8_t *)buf,
+                              len, udpiplen, false, true,
+                              chksum_copy, &state);
           if (blresult >= 0)
             {
               net_restorelock(count);
@@ -846,6 +855,8 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_wrb;
         }
 
+      wrb->wb_sum = state.sum;
+
       /* Dump I/O buffer chain */
 
       UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
@@ -27,84 +27,213 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <string.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHKSUM_SWAP(s)  ((uint16_t)(((s) << 8) | ((s) >> 8)))
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
+
 /****************************************************************************
- * Name: checksum
+ * Name: chksum_native
  *
  * Description:
- *   Calculate the raw change sum over the memory region described by
- *   data and len.
+ *   Calculate the one's complement sum of the 16-bit words in 'src',
+ *   taken in host byte order, and optionally copy 'src' to 'dest' in the
+ *   same pass.  The words are accumulated 32 bits at a time into a 64-bit
+ *   accumulator, so carries only need to be folded once at the end.
  *
  * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to
- *          chksum().  This should be zero on the first time that check
- *          sum is called.
- *   data - Beginning of the data to include in the checksum.
+ *   dest - Destination of the copy, or NULL.
+ *   src  - Beginning of the data to include in the checksum.
  *   len  - Length of the data to include in the checksum.
- *   odd  - the flag of the Calculated data sum
  *
  * Returned Value:
- *   The updated checksum value.
+ *   The folded 16-bit sum, in host byte order.
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
-                    uint16_t len, bool *odd)
+static inline_function uint16_t chksum_native(FAR uint8_t *dest,
+                                              FAR const uint8_t *src,
+                                              size_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *src32;
+  FAR uint32_t *dest32;
+  uint64_t acc = 0;
+  bool swapped = false;
+
+  if (dest != NULL && (((uintptr_t)dest ^ (uintptr_t)src) & 3) != 0)
+    {
+      /* The buffers can never be aligned together, copy first and sum the
+       * destination while it is still in the cache.
+       */
+
+      memcpy(dest, src, len);
+      src  = dest;
+      dest = NULL;
+    }
+
+  /* Sum a leading odd byte in the position it will have after the final
+   * byte swap below.
+   */
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (((uintptr_t)src & 1) != 0 && len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc = *src;
+#else
+      acc = (uint64_t)*src << 8;
+#endif
+      if (dest != NULL)
+        {
+          *dest++ = *src;
+        }
 
-  if (*odd == true)
+      src++;
+      len--;
+      swapped = true;
+    }
+
+  if (((uintptr_t)src & 2) != 0 && len >= 2)
     {
-      t = dataptr[0];
-      sum += t;
-      if (sum < t)
+      uint16_t word = *(FAR const uint16_t *)src;
+
+      if (dest != NULL)
         {
-          sum++; /* carry */
+          *(FAR uint16_t *)dest = word;
+          dest += 2;
         }
 
-      dataptr += 1;
+      acc += word;
+      src += 2;
+      len -= 2;
     }
 
-  while (dataptr < last_byte)
+  src32  = (FAR const uint32_t *)src;
+  dest32 = (FAR uint32_t *)dest;
+
+  for (; len >= 16; len -= 16, src32 += 4)
     {
-      /* At least two more bytes */
+      uint32_t w0 = src32[0];
+      uint32_t w1 = src32[1];
+      uint32_t w2 = src32[2];
+      uint32_t w3 = src32[3];
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
+      if (dest32 != NULL)
         {
-          sum++; /* carry */
+          dest32[0] = w0;
+          dest32[1] = w1;
+          dest32[2] = w2;
+          dest32[3] = w3;
+          dest32 += 4;
         }
 
-      dataptr += 2;
+      acc += (uint64_t)w0 + w1 + w2 + w3;
     }
 
-  *odd = false;
+  for (; len >= 4; len -= 4)
+    {
+      uint32_t word = *src32++;
+
+      if (dest32 != NULL)
+        {
+          *dest32++ = word;
+        }
 
-  if (dataptr == last_byte)
+      acc += word;
+    }
+
+  src  = (FAR const uint8_t *)src32;
+  dest = (FAR uint8_t *)dest32;
+
+  if (len >= 2)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
+      uint16_t word = *(FAR const uint16_t *)src;
+
+      if (dest != NULL)
         {
-          sum++; /* carry */
+          *(FAR uint16_t *)dest = word;
+          dest += 2;
         }
 
-      *odd = true;
+      acc += word;
+      src += 2;
+      len -= 2;
+    }
+
+  /* A trailing odd byte is padded with zero */
+
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint64_t)*src << 8;
+#else
+      acc += *src;
+#endif
+      if (dest != NULL)
+        {
+          *dest = *src;
+        }
     }
 
-  /* Return sum in host byte order. */
+  /* Fold the carries back in: 64 -> 32 -> 16 bits */
+
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  return swapped ? CHKSUM_SWAP((uint16_t)acc) : (uint16_t)acc;
+}
+
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
+/****************************************************************************
+ * Name: chksum_merge
+ *
+ * Description:
+ *   Add the sum 'part' of a 'len' byte block into the running sum of the
+ *   data that preceded it.
+ *
+ * Input Parameters:
+ *   sum  - The running sum, as returned by chksum().
+ *   part - The sum of the block, as returned by chksum(0, ...).
+ *   len  - Length of the block.
+ *   odd  - True if the data before the block had an odd length; updated
+ *          to include the block.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+static uint16_t chksum_merge(uint16_t sum, uint16_t part, size_t len,
+                             FAR bool *odd)
+{
+  /* A block starting at an odd offset contributes its sum byte swapped */
+
+  if (*odd)
+    {
+      part = CHKSUM_SWAP(part);
+    }
+
+  *odd ^= (len & 1) != 0;
+
+  sum += part;
+  if (sum < part)
+    {
+      sum++; /* carry */
+    }
 
   return sum;
 }
@@ -132,15 +261,51 @@ uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
   bool odd = false;
 
-  return checksum(sum, data, len, &odd);
+  return chksum_merge(sum, NTOHS(chksum_native(NULL, data, len)), len,
+                      &odd);
 }
-
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+/****************************************************************************
+ * Name: chksum_copy
+ *
+ * Description:
+ *   Copy 'len' bytes from 'src' to 'dest' and add them to the running
+ *   checksum in 'arg', a struct chksum_copy_s, in the same pass.  The
+ *   prototype matches iob_copyfn_t, so that this can be given to
+ *   iob_copyin_fn() and iob_clone_partial_fn() to checksum the payload
+ *   while it is copied into an I/O buffer chain.
+ *
+ * Input Parameters:
+ *   arg  - The struct chksum_copy_s holding the running sum.  Zero it
+ *          before the first block.
+ *   dest - Destination of the copy.
+ *   src  - Source of the copy.
+ *   len  - Number of bytes to copy.
+ *
+ ****************************************************************************/
+
+void chksum_copy(FAR void *arg, FAR uint8_t *dest,
+                 FAR const uint8_t *src, unsigned int len)
+{
+  FAR struct chksum_copy_s *state = arg;
+  uint16_t part;
+
+#ifdef CONFIG_NET_ARCH_CHKSUM
+  memcpy(dest, src, len);
+  part = chksum(0, dest, len);
+#else
+  part = NTOHS(chksum_native(dest, src, len));
+#endif
+
+  state->sum = chksum_merge(state->sum, part, len, &state->odd);
+}
+
 /****************************************************************************
  * Name: chksum_iob
  *
@@ -178,8 +343,11 @@ uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 
   while (iob != NULL)
     {
-      sum = checksum(sum, iob->io_data + iob->io_offset + offset,
-                      iob->io_len - offset, &odd);
+      uint16_t len = iob->io_len - offset;
+
+      sum = chksum_merge(sum, chksum(0, iob->io_data + iob->io_offset +
+                                        offset, len),
+                         len, &odd);
       iob = iob->io_flink;
       offset = 0;
     }
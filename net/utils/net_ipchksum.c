@@ -35,6 +35,61 @@
 
 #ifdef CONFIG_NET
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM) && defined(CONFIG_MM_IOB) && \
+    (defined(CONFIG_NET_IPv4) || defined(CONFIG_NET_IPv6))
+
+/****************************************************************************
+ * Name: upperlayer_sndpayload_chksum
+ *
+ * Description:
+ *   Sum the 'upperlen' byte TCP or UDP segment at 'offset' in d_iob.  If
+ *   the application data at its end was already summed while it was
+ *   copied in (see devif_iob_send()), only the protocol header in front of
+ *   it is read here.  The recorded sum is discarded either way, so that it
+ *   can never be applied to a later packet built in the same d_iob.
+ *
+ ****************************************************************************/
+
+static uint16_t upperlayer_sndpayload_chksum(FAR struct net_driver_s *dev,
+                                             uint16_t sum,
+                                             unsigned int offset,
+                                             unsigned int upperlen)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  unsigned int sndsumlen = dev->d_sndsumlen;
+  unsigned int hdrlen;
+
+  dev->d_sndsumlen = 0;
+
+  if (sndsumlen != 0 && sndsumlen == dev->d_sndlen && upperlen >= sndsumlen)
+    {
+      /* The header must be even sized, so that the payload sum needs no
+       * byte swap, and lie within the first I/O buffer.
+       */
+
+      hdrlen = upperlen - sndsumlen;
+      if ((hdrlen & 1) == 0 && offset + hdrlen <= iob->io_len)
+        {
+          sum  = chksum(sum, IOB_DATA(iob) + offset, hdrlen);
+          sum += dev->d_sndsum;
+          if (sum < dev->d_sndsum)
+            {
+              sum++; /* carry */
+            }
+
+          return sum;
+        }
+    }
+
+  return chksum_iob(sum, iob, offset);
+}
+
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -141,15 +196,30 @@ uint16_t ipv4_upperlayer_payload_chksum(FAR struct net_driver_s *dev,
 
 uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 {
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  uint16_t upperlen;
+  uint16_t iphdrlen;
   uint16_t sum;
 
   /* Sum pseudo-header IP source and destination addresses. */
 
   sum = ipv4_upperlayer_header_chksum(dev, proto);
 
-  /* Sum IP payload data. */
+  /* Sum IP payload data.  Only TCP and UDP record the sum of the data
+   * they copy in.
+   */
 
-  sum = ipv4_upperlayer_payload_chksum(dev, sum);
+  if (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP)
+    {
+      iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      upperlen = (((uint16_t)(ipv4->len[0]) << 8) + ipv4->len[1]) -
+                 iphdrlen;
+      sum = upperlayer_sndpayload_chksum(dev, sum, iphdrlen, upperlen);
+    }
+  else
+    {
+      sum = ipv4_upperlayer_payload_chksum(dev, sum);
+    }
 
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
@@ -262,15 +332,30 @@ uint16_t ipv6_upperlayer_payload_chksum(FAR struct net_driver_s *dev,
 uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
                                 uint8_t proto, unsigned int iplen)
 {
+  FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+  uint16_t upperlen;
   uint16_t sum;
 
   /* Sum IP source and destination addresses. */
 
   sum = ipv6_upperlayer_header_chksum(dev, proto, iplen);
 
-  /* Sum IP payload data. */
+  /* Sum IP payload data.  Only TCP and UDP record the sum of the data
+   * they copy in.
+   */
 
-  sum = ipv6_upperlayer_payload_chksum(dev, iplen, sum);
+  if (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP)
+    {
+      /* The IPv6 payload length includes any extension headers */
+
+      upperlen = (((uint16_t)ipv6->len[0] << 8) + ipv6->len[1]) -
+                 (iplen - IPv6_HDRLEN);
+      sum = upperlayer_sndpayload_chksum(dev, sum, iplen, upperlen);
+    }
+  else
+    {
+      sum = ipv6_upperlayer_payload_chksum(dev, iplen, sum);
+    }
 
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
@@ -184,6 +184,11 @@ extern dq_queue_t g_readytorun;
  * CPU.  Tasks after the active task are ready-to-run and assigned to this
  * CPU. The tail of this assigned task list, the lowest priority task, is
  * always the CPU's IDLE task.
+ *
+ * REVISIT:  g_readytorun, g_pendingtasks and every g_assignedtasks[] list
+ * are still protected together by the global critical section.  Per-CPU
+ * run queues with their own spinlocks and a load balancer are not yet
+ * implemented; nxsched_select_cpu() only chooses where a task starts.
  */
 
 extern dq_queue_t g_assignedtasks[CONFIG_SMP_NCPUS];
@@ -390,7 +395,7 @@ static inline_function FAR struct tcb_s *this_task(void)
 #ifdef CONFIG_SMP
 void nxsched_process_delivered(int cpu);
 #else
-#  define nxsched_select_cpu(a)     (0)
+#  define nxsched_select_cpu(a, p)  (0)
 #endif
 
 #define nxsched_islocked_tcb(tcb)   ((tcb)->lockcount > 0)
@@ -516,12 +521,30 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
 }
 
 #  ifdef CONFIG_SMP
-static inline_function int nxsched_select_cpu(cpu_set_t affinity)
+/* Select the CPU to run a task that may use the CPUs in 'affinity'.  An
+ * idle CPU is used first, starting with 'prefer', the CPU the task last
+ * ran on, whose cache may still be warm.  Otherwise the CPU running the
+ * lowest priority task is used; on a tie this CPU is picked, since it can
+ * switch without an inter-processor interrupt.
+ */
+
+static inline_function int nxsched_select_cpu(cpu_set_t affinity,
+                                              int prefer)
 {
+  FAR struct tcb_s *rtcb;
   uint8_t minprio;
+  int me;
   int cpu;
   int i;
 
+  if (prefer >= 0 && prefer < CONFIG_SMP_NCPUS &&
+      (affinity & (1 << prefer)) != 0 &&
+      is_idle_task(current_task(prefer)))
+    {
+      return prefer;
+    }
+
+  me      = this_cpu();
   minprio = SCHED_PRIORITY_MAX;
   cpu     = 0xff;
 
@@ -531,8 +554,7 @@ static inline_function int nxsched_select_cpu(cpu_set_t affinity)
 
       if ((affinity & (1 << i)) != 0)
         {
-          FAR struct tcb_s *rtcb = (FAR struct tcb_s *)
-                                   g_assignedtasks[i].head;
+          rtcb = current_task(i);
 
           /* If this CPU is executing its IDLE task, then use it.  The
            * IDLE task is always the last task in the assigned task list.
@@ -547,7 +569,8 @@ static inline_function int nxsched_select_cpu(cpu_set_t affinity)
               DEBUGASSERT(rtcb->sched_priority == 0);
               return i;
             }
-          else if (rtcb->sched_priority <= minprio)
+          else if (cpu == 0xff || rtcb->sched_priority < minprio ||
+                   (rtcb->sched_priority == minprio && i == me))
             {
               DEBUGASSERT(rtcb->sched_priority > 0);
               minprio = rtcb->sched_priority;
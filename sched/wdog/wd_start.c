@@ -82,6 +82,23 @@
 
 #endif
 
+/* The timer wheel has WDOG_WHEEL_LEVELS levels of WDOG_WHEEL_SLOTS slots.
+ * A slot of level n covers 2^(n * WDOG_WHEEL_BITS) ticks, so the wheel
+ * spans WDOG_WHEEL_SPAN ticks.  Watchdogs further in the future are parked
+ * in the last slot of the top level and re-inserted when it cascades.
+ */
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+#  define WDOG_WHEEL_BITS        6
+#  define WDOG_WHEEL_SLOTS       (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK        (WDOG_WHEEL_SLOTS - 1)
+#  define WDOG_WHEEL_LEVELS      4
+#  define WDOG_WHEEL_SPAN        \
+     ((sclock_t)1 << (WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS))
+#  define WDOG_WHEEL_INDEX(t, l) \
+     (((t) >> ((l) * WDOG_WHEEL_BITS)) & WDOG_WHEEL_MASK)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,10 +107,263 @@
 static unsigned int g_wdtimernested;
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+/* The slots of the timer wheel, each an unsorted list of watchdogs */
+
+static struct list_node g_wdwheel[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+
+/* The next tick to be processed by wd_expiration() */
+
+static clock_t g_wdwheeltime;
+static bool g_wdwheelinit;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timer wheel slots on first use and start processing
+ *   from the current tick.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_initialize(void)
+{
+  int level;
+  int slot;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      for (slot = 0; slot < WDOG_WHEEL_SLOTS; slot++)
+        {
+          list_initialize(&g_wdwheel[level][slot]);
+        }
+    }
+
+  g_wdwheeltime = clock_systime_ticks();
+  g_wdwheelinit = true;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Put an active watchdog into the slot of the lowest wheel level that
+ *   can hold its expiration time.  Watchdogs that are already expired go
+ *   to the slot of the tick that is processed next.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  sclock_t delta = wdog->expired - g_wdwheeltime;
+  clock_t when = wdog->expired;
+  int level = 0;
+
+  if (delta < 0)
+    {
+      when = g_wdwheeltime;
+    }
+  else if (delta >= WDOG_WHEEL_SPAN)
+    {
+      when  = g_wdwheeltime + WDOG_WHEEL_SPAN - 1;
+      level = WDOG_WHEEL_LEVELS - 1;
+    }
+  else
+    {
+      while (delta >= ((sclock_t)1 << ((level + 1) * WDOG_WHEEL_BITS)))
+        {
+          level++;
+        }
+    }
+
+  list_add_tail(&g_wdwheel[level][WDOG_WHEEL_INDEX(when, level)],
+                &wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Re-insert all watchdogs of a slot.  Called when the wheel time enters
+ *   the interval covered by the slot, so they all move to lower levels.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(FAR struct list_node *slot)
+{
+  struct list_node pending;
+  FAR struct wdog_s *wdog;
+
+  /* Detach the slot first so that nothing re-inserted into the same slot
+   * is visited twice.
+   */
+
+  list_initialize(&pending);
+  if (!list_is_empty(slot))
+    {
+      pending.next       = slot->next;
+      pending.prev       = slot->prev;
+      pending.next->prev = &pending;
+      pending.prev->next = &pending;
+      list_initialize(slot);
+    }
+
+  while (!list_is_empty(&pending))
+    {
+      wdog = list_first_entry(&pending, struct wdog_s, node);
+      list_delete(&wdog->node);
+      wd_wheel_add(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_rebase
+ *
+ * Description:
+ *   Move the wheel time forward to 'ticks' in one step, re-inserting every
+ *   watchdog.  Used when more than a full wheel span has elapsed since the
+ *   last tick that was processed.
+ *
+ * Assumptions:
+ *   Called with g_wdspinlock held.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_rebase(clock_t ticks)
+{
+  struct list_node pending;
+  FAR struct wdog_s *wdog;
+  int level;
+  int slot;
+
+  list_initialize(&pending);
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      for (slot = 0; slot < WDOG_WHEEL_SLOTS; slot++)
+        {
+          while (!list_is_empty(&g_wdwheel[level][slot]))
+            {
+              wdog = list_first_entry(&g_wdwheel[level][slot],
+                                      struct wdog_s, node);
+              list_delete(&wdog->node);
+              list_add_tail(&pending, &wdog->node);
+            }
+        }
+    }
+
+  g_wdwheeltime = ticks;
+
+  while (!list_is_empty(&pending))
+    {
+      wdog = list_first_entry(&pending, struct wdog_s, node);
+      list_delete(&wdog->node);
+      wd_wheel_add(wdog);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_expiration
+ *
+ * Description:
+ *   Process every tick of the timer wheel up to and including 'ticks':
+ *   cascade the upper levels at slot boundaries and run the watchdogs of
+ *   the tick's level 0 slot.
+ *
+ * Input Parameters:
+ *   ticks - current time in ticks
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline_function void wd_expiration(clock_t ticks)
+{
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  irqstate_t flags;
+  wdentry_t func;
+  wdparm_t arg;
+  int level;
+
+  flags = spin_lock_irqsave(&g_wdspinlock);
+
+  if (!g_wdwheelinit)
+    {
+      wd_wheel_initialize();
+    }
+
+  if ((sclock_t)(ticks - g_wdwheeltime) >= WDOG_WHEEL_SPAN)
+    {
+      wd_wheel_rebase(ticks);
+    }
+
+  while (clock_compare(g_wdwheeltime, ticks))
+    {
+      /* Entering a new interval of level n - 1 means the matching slot of
+       * level n is due to be spread over the lower levels.
+       */
+
+      for (level = 1;
+           level < WDOG_WHEEL_LEVELS &&
+           WDOG_WHEEL_INDEX(g_wdwheeltime, level - 1) == 0;
+           level++)
+        {
+          wd_wheel_cascade(
+            &g_wdwheel[level][WDOG_WHEEL_INDEX(g_wdwheeltime, level)]);
+        }
+
+      /* Every watchdog in this slot expires at (or before) this tick */
+
+      slot = &g_wdwheel[0][WDOG_WHEEL_INDEX(g_wdwheeltime, 0)];
+      while (!list_is_empty(slot))
+        {
+          wdog = list_first_entry(slot, struct wdog_s, node);
+          DEBUGASSERT(clock_compare(wdog->expired, g_wdwheeltime));
+
+          list_delete(&wdog->node);
+
+          /* Indicate that the watchdog is no longer active. */
+
+          func = wdog->func;
+          arg = wdog->arg;
+          wdog->func = NULL;
+
+          /* Execute the watchdog function */
+
+          up_setpicbase(wdog->picbase);
+          spin_unlock_irqrestore(&g_wdspinlock, flags);
+
+          CALL_FUNC(func, arg);
+
+          flags = spin_lock_irqsave(&g_wdspinlock);
+        }
+
+      g_wdwheeltime++;
+    }
+
+  spin_unlock_irqrestore(&g_wdspinlock, flags);
+}
+
+#else /* CONFIG_WDOG_TIMER_WHEEL */
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -170,12 +440,16 @@ static inline_function void wd_expiration(clock_t ticks)
   spin_unlock_irqrestore(&g_wdspinlock, flags);
 }
 
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
+
 /****************************************************************************
  * Name: wd_insert
  *
  * Description:
  *   Insert the timer into the global list to ensure that
  *   the list is sorted in increasing order of expiration absolute time.
+ *   With CONFIG_WDOG_TIMER_WHEEL the timer is put into its timer wheel
+ *   slot instead, which takes constant time.
  *
  * Input Parameters:
  *   wdog     - Watchdog ID
@@ -195,6 +469,15 @@ static inline_function
 void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  if (!g_wdwheelinit)
+    {
+      wd_wheel_initialize();
+    }
+
+  wdog->expired = expired;
+  wd_wheel_add(wdog);
+#else
   FAR struct wdog_s *curr;
 
   /* Traverse the watchdog list */
@@ -217,6 +500,7 @@ void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
    */
 
   list_add_before(&curr->node, &wdog->node);
+#endif
 
   wdog->func = wdentry;
   up_getpicbase(&wdog->picbase);
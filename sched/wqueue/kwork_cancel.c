@@ -67,9 +67,9 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
 
       work->worker = NULL;
       wd_cancel(&work->u.timer);
-      if (dq_inqueue((FAR dq_entry_t *)work, &wqueue->q))
+      if (dq_inqueue((FAR dq_entry_t *)work, work_pendq(wqueue, work)))
         {
-          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+          dq_rem((FAR dq_entry_t *)work, work_pendq(wqueue, work));
         }
 
       ret = OK;
@@ -34,6 +34,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/queue.h>
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -41,25 +42,84 @@
 #ifdef CONFIG_SCHED_WORKQUEUE
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Private Functions
  ****************************************************************************/
 
-#define queue_work(wqueue, work) \
-  do \
-    { \
-      dq_addlast((FAR dq_entry_t *)(work), &(wqueue)->q); \
-      if ((wqueue)->wait_count > 0) /* There are threads waiting for sem. */ \
-        { \
-          (wqueue)->wait_count--; \
-          nxsem_post(&(wqueue)->sem); \
-        } \
-    } \
-  while (0)
+/****************************************************************************
+ * Name: work_idleworker
+ *
+ * Description:
+ *   Return an idle worker of the work queue, preferring one that is bound
+ *   to the given CPU.  At least one worker must be idle.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static FAR struct kworker_s *
+work_idleworker(FAR struct kwork_wqueue_s *wqueue, int cpu)
+{
+  FAR struct kworker_s *idle = NULL;
+  int wndx;
+
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      FAR struct kworker_s *kworker = &wqueue->worker[wndx];
+
+      if (kworker->idle)
+        {
+          if (kworker->cpu == cpu)
+            {
+              return kworker;
+            }
+          else if (idle == NULL)
+            {
+              idle = kworker;
+            }
+        }
+    }
+
+  DEBUGASSERT(idle != NULL);
+  return idle;
+}
+#endif
 
 /****************************************************************************
- * Private Functions
+ * Name: queue_work
+ *
+ * Description:
+ *   Add the work to its pending list and wake up an idle worker, if any.
+ *
+ * Assumptions:
+ *   Called with the work queue locked.
+ *
  ****************************************************************************/
 
+static void queue_work(FAR struct kwork_wqueue_s *wqueue,
+                       FAR struct work_s *work)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  work->stime = perf_gettime();
+#endif
+
+  dq_addlast((FAR dq_entry_t *)work, work_pendq(wqueue, work));
+
+  /* Are there threads waiting for work? */
+
+  if (wqueue->wait_count > 0)
+    {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      FAR struct kworker_s *kworker = work_idleworker(wqueue, work->cpu);
+
+      kworker->idle = false;
+      wqueue->wait_count--;
+      nxsem_post(&kworker->sem);
+#else
+      wqueue->wait_count--;
+      nxsem_post(&wqueue->sem);
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: work_timer_expiry
  ****************************************************************************/
@@ -102,42 +162,16 @@ static bool work_is_canceling(FAR struct kworker_s *kworkers, int nthreads,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: work_queue/work_queue_wq
+ * Name: work_qqueue
  *
  * Description:
- *   Queue work to be performed at a later time.  All queued work will be
- *   performed on the worker thread of execution (not the caller's).
- *
- *   The work structure is allocated and must be initialized to all zero by
- *   the caller.  Otherwise, the work structure is completely managed by the
- *   work queue logic.  The caller should never modify the contents of the
- *   work queue structure directly.  If work_queue() is called before the
- *   previous work has been performed and removed from the queue, then any
- *   pending work will be canceled and lost.
- *
- * Input Parameters:
- *   qid    - The work queue ID (must be HPWORK or LPWORK)
- *   wqueue - The work queue handle
- *   work   - The work structure to queue
- *   worker - The worker callback to be invoked.  The callback will be
- *            invoked on the worker thread of execution.
- *   arg    - The argument that will be passed to the worker callback when
- *            it is invoked.
- *   delay  - Delay (in clock ticks) from the time queue until the worker
- *            is invoked. Zero means to perform the work immediately.
- *
- * Returned Value:
- *   Zero on success, a negated errno on failure
+ *   Queue work on the pending list of the given CPU.  See work_queue_wq().
  *
  ****************************************************************************/
 
-int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
-                  FAR struct work_s *work, worker_t worker,
-                  FAR void *arg, clock_t delay)
+static int work_qqueue(FAR struct kwork_wqueue_s *wqueue, int cpu,
+                       FAR struct work_s *work, worker_t worker,
+                       FAR void *arg, clock_t delay)
 {
   irqstate_t flags;
 
@@ -162,9 +196,9 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
 
       work->worker = NULL;
       wd_cancel(&work->u.timer);
-      if (dq_inqueue((FAR dq_entry_t *)work, &wqueue->q))
+      if (dq_inqueue((FAR dq_entry_t *)work, work_pendq(wqueue, work)))
         {
-          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+          dq_rem((FAR dq_entry_t *)work, work_pendq(wqueue, work));
         }
     }
 
@@ -179,6 +213,9 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
   work->worker = worker;           /* Work callback. non-NULL means queued */
   work->arg    = arg;              /* Callback argument */
   work->wq     = wqueue;           /* Work queue */
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  work->cpu    = cpu < 0 ? this_cpu() : cpu;
+#endif
 
   /* Queue the new work */
 
@@ -198,10 +235,92 @@ int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
   return 0;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_queue/work_queue_wq
+ *
+ * Description:
+ *   Queue work to be performed at a later time.  All queued work will be
+ *   performed on the worker thread of execution (not the caller's).
+ *
+ *   The work structure is allocated and must be initialized to all zero by
+ *   the caller.  Otherwise, the work structure is completely managed by the
+ *   work queue logic.  The caller should never modify the contents of the
+ *   work queue structure directly.  If work_queue() is called before the
+ *   previous work has been performed and removed from the queue, then any
+ *   pending work will be canceled and lost.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   wqueue - The work queue handle
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will be
+ *            invoked on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            it is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay)
+{
+  return work_qqueue(wqueue, -1, work, worker, arg, delay);
+}
+
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  return work_queue_wq(work_qid2wq(qid), work, worker, arg, delay);
+  return work_qqueue(work_qid2wq(qid), -1, work, worker, arg, delay);
+}
+
+/****************************************************************************
+ * Name: work_queue_cpu/work_queue_cpu_wq
+ *
+ * Description:
+ *   Like work_queue()/work_queue_wq(), but queue the work on the pending
+ *   list of the given CPU instead of the calling CPU's.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   wqueue - The work queue handle
+ *   cpu    - The CPU to queue the work on
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_cpu_wq(FAR struct kwork_wqueue_s *wqueue, int cpu,
+                      FAR struct work_s *work, worker_t worker,
+                      FAR void *arg, clock_t delay)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  return work_qqueue(wqueue, cpu, work, worker, arg, delay);
+}
+
+int work_queue_cpu(int qid, int cpu, FAR struct work_s *work,
+                   worker_t worker, FAR void *arg, clock_t delay)
+{
+  return work_queue_cpu_wq(work_qid2wq(qid), cpu, work, worker, arg,
+                           delay);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -110,6 +110,80 @@ struct lp_wqueue_s g_lpwork =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove the next pending work for a worker.  With per-CPU work queues
+ *   the work queued on the worker's own CPU is taken first, then work is
+ *   stolen from the other CPUs in turn.
+ *
+ * Assumptions:
+ *   Called with the work queue locked.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_dequeue(FAR struct kwork_wqueue_s *wqueue,
+                                       FAR struct kworker_s *kworker)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct work_s *work;
+  int cpu = kworker->cpu;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      work = (FAR struct work_s *)dq_remfirst(&wqueue->cpuq[cpu]);
+      if (work != NULL)
+        {
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          if (i > 0)
+            {
+              wqueue->stats.nsteals++;
+            }
+#endif
+
+          return work;
+        }
+
+      if (++cpu >= CONFIG_SMP_NCPUS)
+        {
+          cpu = 0;
+        }
+    }
+
+  return NULL;
+#else
+  return (FAR struct work_s *)dq_remfirst(&wqueue->q);
+#endif
+}
+
+/****************************************************************************
+ * Name: work_update_stats
+ *
+ * Description:
+ *   Account for the time a work spent pending before being run.
+ *
+ * Assumptions:
+ *   Called with the work queue locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+static void work_update_stats(FAR struct kwork_wqueue_s *wqueue,
+                              FAR struct work_s *work)
+{
+  clock_t elapsed = perf_gettime() - work->stime;
+
+  wqueue->stats.nworks++;
+  wqueue->stats.latency += elapsed;
+  if (elapsed > wqueue->stats.maxlatency)
+    {
+      wqueue->stats.maxlatency = elapsed;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: work_thread
  *
@@ -161,13 +235,17 @@ static int work_thread(int argc, FAR char *argv[])
 
       /* Remove the ready-to-execute work from the list */
 
-      while ((work = (FAR struct work_s *)dq_remfirst(&wqueue->q)) != NULL)
+      while ((work = work_dequeue(wqueue, kworker)) != NULL)
         {
           if (work->worker == NULL)
             {
               continue;
             }
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          work_update_stats(wqueue, work);
+#endif
+
           /* Extract the work description from the entry (in case the work
            * instance will be re-used after it has been de-queued).
            */
@@ -218,9 +296,18 @@ static int work_thread(int argc, FAR char *argv[])
 
       wqueue->wait_count++;
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Wait to be picked by queue_work() or by work_queue_free() */
+
+      kworker->idle = true;
+      spin_unlock_irqrestore(&wqueue->lock, flags);
+
+      nxsem_wait_uninterruptible(&kworker->sem);
+#else
       spin_unlock_irqrestore(&wqueue->lock, flags);
 
       nxsem_wait_uninterruptible(&wqueue->sem);
+#endif
 
       flags = spin_lock_irqsave(&wqueue->lock);
     }
@@ -257,6 +344,9 @@ static int work_thread_create(FAR const char *name, int priority,
   FAR char *argv[3];
   char arg0[32];
   char arg1[32];
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  cpu_set_t cpuset;
+#endif
   int wndx;
   int pid;
 
@@ -269,6 +359,10 @@ static int work_thread_create(FAR const char *name, int priority,
   for (wndx = 0; wndx < wqueue->nthreads; wndx++)
     {
       nxsem_init(&wqueue->worker[wndx].wait, 0, 0);
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      nxsem_init(&wqueue->worker[wndx].sem, 0, 0);
+      wqueue->worker[wndx].cpu = wndx % CONFIG_SMP_NCPUS;
+#endif
 
       snprintf(arg0, sizeof(arg0), "%p", wqueue);
       snprintf(arg1, sizeof(arg1), "%p", &wqueue->worker[wndx]);
@@ -288,6 +382,14 @@ static int work_thread_create(FAR const char *name, int priority,
         }
 
       wqueue->worker[wndx].pid = pid;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Bind the worker to its CPU */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(wqueue->worker[wndx].cpu, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpuset), &cpuset);
+#endif
     }
 
   sched_unlock();
@@ -395,7 +497,11 @@ int work_queue_free(FAR struct kwork_wqueue_s *wqueue)
 
   for (wndx = 0; wndx < wqueue->nthreads; wndx++)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      nxsem_post(&wqueue->worker[wndx].sem);
+#else
       nxsem_post(&wqueue->sem);
+#endif
     }
 
   for (wndx = 0; wndx < wqueue->nthreads; wndx++)
@@ -403,6 +509,13 @@ int work_queue_free(FAR struct kwork_wqueue_s *wqueue)
       nxsem_wait_uninterruptible(&wqueue->exsem);
     }
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      nxsem_destroy(&wqueue->worker[wndx].sem);
+    }
+#endif
+
   nxsem_destroy(&wqueue->sem);
   nxsem_destroy(&wqueue->exsem);
   kmm_free(wqueue);
@@ -450,6 +563,46 @@ int work_queue_priority(int qid)
   return work_queue_priority_wq(work_qid2wq(qid));
 }
 
+/****************************************************************************
+ * Name: work_queue_stats/work_queue_stats_wq
+ *
+ * Description:
+ *   Return a snapshot of the queueing statistics of a work queue.
+ *
+ * Input Parameters:
+ *  qid    - The work queue ID
+ *  wqueue - The work queue handle
+ *  stats  - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_queue_stats_wq(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_stats_s *stats)
+{
+  irqstate_t flags;
+
+  if (wqueue == NULL || stats == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&wqueue->lock);
+  memcpy(stats, &wqueue->stats, sizeof(struct work_stats_s));
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+
+  return 0;
+}
+
+int work_queue_stats(int qid, FAR struct work_stats_s *stats)
+{
+  return work_queue_stats_wq(work_qid2wq(qid), stats);
+}
+#endif
+
 /****************************************************************************
  * Name: work_start_highpri
  *
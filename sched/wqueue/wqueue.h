@@ -60,6 +60,11 @@ struct kworker_s
   FAR struct work_s *work;     /* The work structure */
   sem_t             wait;      /* Sync waiting for worker done */
   int16_t           wait_count;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  sem_t             sem;       /* Wakes the worker up when it is idle */
+  uint8_t           cpu;       /* The CPU that the worker is bound to */
+  bool              idle;      /* The worker is waiting on sem */
+#endif
 };
 
 /* This structure defines the state of one kernel-mode work queue */
@@ -73,6 +78,18 @@ struct kwork_wqueue_s
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
   int16_t           wait_count;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  /* The per-CPU lists are protected by 'lock' as well: queueing, stealing
+   * and canceling all update the worker idle/work/wait_count state along
+   * with the list, so a per-list lock would only be taken nested inside
+   * 'lock' and would not shorten any critical section.
+   */
+
+  struct dq_queue_s cpuq[CONFIG_SMP_NCPUS]; /* Pending work of each CPU */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stats_s stats;   /* Queueing statistics */
+#endif
   struct kworker_s  worker[0]; /* Describes a worker thread */
 };
 
@@ -90,6 +107,12 @@ struct hp_wqueue_s
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
   int16_t           wait_count;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  struct dq_queue_s cpuq[CONFIG_SMP_NCPUS]; /* Pending work of each CPU */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stats_s stats;   /* Queueing statistics */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -111,6 +134,12 @@ struct lp_wqueue_s
   uint8_t           nthreads;  /* Number of worker threads */
   bool              exit;      /* A flag to request the thread to exit */
   int16_t           wait_count;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  struct dq_queue_s cpuq[CONFIG_SMP_NCPUS]; /* Pending work of each CPU */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stats_s stats;   /* Queueing statistics */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -159,6 +188,25 @@ static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
     }
 }
 
+/****************************************************************************
+ * Name: work_pendq
+ *
+ * Description:
+ *   Return the list of pending work that a work structure is (or was last)
+ *   queued on.
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct dq_queue_s *
+work_pendq(FAR struct kwork_wqueue_s *wqueue, FAR struct work_s *work)
+{
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  return &wqueue->cpuq[work->cpu];
+#else
+  return &wqueue->q;
+#endif
+}
+
 /****************************************************************************
  * Name: work_start_highpri
  *